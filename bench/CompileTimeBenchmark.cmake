@@ -0,0 +1,105 @@
+# WhispArg.hpp をインクルードする翻訳単位のコンパイル時間ベンチマーク
+#
+# Argument<T> の宣言数ごとに翻訳単位を生成してコンパイルし、以下を計測する。
+#   - コンパイルの所要時間
+#   - オブジェクトファイルのサイズ
+#   - Clang の場合は -ftime-trace によるフロントエンド時間とテンプレート実体化の回数
+#
+# 使い方:
+#   cmake -DCOMPILER=<c++> -DCOMPILER_ID=<GNU|Clang> -DINCLUDE_DIR=<include> -DOUTPUT_DIR=<dir>
+#         -DDECLARATION_COUNTS=1,50,500 -P CompileTimeBenchmark.cmake
+cmake_minimum_required(VERSION 3.23)
+
+foreach(variable COMPILER INCLUDE_DIR OUTPUT_DIR)
+  if (NOT DEFINED ${variable})
+    message(FATAL_ERROR "${variable} is required.")
+  endif()
+endforeach()
+if (NOT DEFINED DECLARATION_COUNTS)
+  set(DECLARATION_COUNTS "1,50,500")
+endif()
+string(REPLACE "," ";" DECLARATION_COUNTS "${DECLARATION_COUNTS}")
+file(MAKE_DIRECTORY ${OUTPUT_DIR})
+
+# 宣言に使用する型 (自動変換に対応する型をすべて含める)
+set(argument_types
+  int8_t int16_t int32_t int64_t uint8_t uint16_t uint32_t uint64_t
+  float double "long double" std::string bool idofront::whisparg::type::Flag)
+list(LENGTH argument_types argument_type_count)
+
+# 表形式で 1 行を出力する
+function(print_row)
+  set(line "")
+  foreach(cell ${ARGN})
+    string(LENGTH "${cell}" length)
+    foreach(padding RANGE ${length} 20)
+      string(APPEND line " ")
+    endforeach()
+    string(APPEND line "${cell}")
+  endforeach()
+  message("${line}")
+endfunction()
+
+set(report "declarations,wall_ms,object_bytes,frontend_ms,instantiate_function_count,instantiate_class_count\n")
+print_row(declarations wall[ms] object[B] frontend[ms] InstantiateFunction InstantiateClass)
+
+foreach(declaration_count ${DECLARATION_COUNTS})
+  # 翻訳単位の生成
+  set(source "#include <idofront/WhispArg.hpp>\n\n")
+  string(APPEND source "int main(int argc, char *argv[])\n{\n")
+  string(APPEND source "    auto parser = idofront::whisparg::WhispArg(argc, argv);\n")
+  math(EXPR last_index "${declaration_count} - 1")
+  foreach(index RANGE ${last_index})
+    math(EXPR type_index "${index} % ${argument_type_count}")
+    list(GET argument_types ${type_index} argument_type)
+    string(APPEND source
+      "    auto option${index} = parser.Parse(idofront::whisparg::Argument<${argument_type}>::New(\"option-${index}\")"
+      ".Description(\"Option ${index} of the benchmark.\"));\n")
+  endforeach()
+  string(APPEND source "    parser.ShowHelp();\n    return 0;\n}\n")
+
+  set(source_path ${OUTPUT_DIR}/CompileTime${declaration_count}.cpp)
+  set(object_path ${OUTPUT_DIR}/CompileTime${declaration_count}.o)
+  set(trace_path ${OUTPUT_DIR}/CompileTime${declaration_count}.json)
+  file(WRITE ${source_path} "${source}")
+
+  set(flags -std=c++17 -O2 -I${INCLUDE_DIR} -c ${source_path} -o ${object_path})
+  if (COMPILER_ID STREQUAL "Clang" OR COMPILER_ID STREQUAL "AppleClang")
+    list(APPEND flags -ftime-trace -ftime-trace-granularity=0)
+  endif()
+
+  # コンパイル
+  string(TIMESTAMP start "%s%f" UTC)
+  execute_process(COMMAND ${COMPILER} ${flags} RESULT_VARIABLE result ERROR_VARIABLE error)
+  string(TIMESTAMP end "%s%f" UTC)
+  if (NOT result EQUAL 0)
+    message(FATAL_ERROR "Failed to compile ${source_path}:\n${error}")
+  endif()
+  math(EXPR wall_ms "(${end} - ${start}) / 1000")
+  file(SIZE ${object_path} object_bytes)
+
+  # -ftime-trace の集計値 ("Total <name>" のイベント) を読み取る
+  set(frontend_ms "-")
+  set(instantiate_function_count "-")
+  set(instantiate_class_count "-")
+  if (EXISTS ${trace_path})
+    file(READ ${trace_path} trace)
+    if (trace MATCHES "\"dur\":([0-9]+),\"name\":\"Total Frontend\"")
+      math(EXPR frontend_ms "${CMAKE_MATCH_1} / 1000")
+    endif()
+    if (trace MATCHES "\"name\":\"Total InstantiateFunction\",\"args\":{\"count\":([0-9]+)")
+      set(instantiate_function_count ${CMAKE_MATCH_1})
+    endif()
+    if (trace MATCHES "\"name\":\"Total InstantiateClass\",\"args\":{\"count\":([0-9]+)")
+      set(instantiate_class_count ${CMAKE_MATCH_1})
+    endif()
+  endif()
+
+  string(APPEND report
+    "${declaration_count},${wall_ms},${object_bytes},${frontend_ms},${instantiate_function_count},${instantiate_class_count}\n")
+  print_row(${declaration_count} ${wall_ms} ${object_bytes} ${frontend_ms} ${instantiate_function_count}
+            ${instantiate_class_count})
+endforeach()
+
+file(WRITE ${OUTPUT_DIR}/compile_time.csv "${report}")
+message("Results were written to ${OUTPUT_DIR}/compile_time.csv")
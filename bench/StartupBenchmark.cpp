@@ -0,0 +1,223 @@
+/*
+ Copyright (c) 2024 idofront
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// Measures the wall time from spawning a WhispArg-based binary to its exit.
+// Each target is spawned with --help, --version and a typical invocation, and the latency distribution, the static
+// initialization time and the binary size are reported.
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <idofront/WhispArg.hpp>
+#include <iomanip>
+#include <iostream>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+namespace
+{
+/// @brief Spawns @c arguments and waits for it to exit.
+/// @param outputFd The descriptor that receives stdout and stderr of the child.
+void Run(const std::vector<std::string> &arguments, int outputFd, char *const *environment)
+{
+    auto argv = std::vector<char *>();
+    std::transform(arguments.begin(), arguments.end(), std::back_inserter(argv),
+                   [](const std::string &argument) { return const_cast<char *>(argument.c_str()); });
+    argv.push_back(nullptr);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, outputFd, STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, outputFd, STDERR_FILENO);
+
+    pid_t pid;
+    auto error = posix_spawn(&pid, argv[0], &actions, nullptr, argv.data(), environment);
+    posix_spawn_file_actions_destroy(&actions);
+    if (error != 0)
+    {
+        throw std::runtime_error("Failed to spawn \"" + arguments[0] + "\": " + std::strerror(error));
+    }
+
+    int status;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+        throw std::runtime_error("\"" + arguments[0] + "\" did not exit successfully.");
+    }
+}
+
+/// @brief Gets the given percentile of sorted samples.
+double Percentile(const std::vector<double> &sortedSamples, double percentile)
+{
+    if (sortedSamples.empty())
+    {
+        throw std::runtime_error("No samples to take a percentile of.");
+    }
+    auto index = static_cast<std::size_t>(percentile / 100.0 * (sortedSamples.size() - 1));
+    return sortedSamples[index];
+}
+
+/// @brief Measures the spawn-to-exit latency in microseconds.
+std::vector<double> MeasureLatency(const std::vector<std::string> &arguments, uint32_t runs, int nullFd)
+{
+    auto samples = std::vector<double>();
+    for (auto i = uint32_t(0); i < runs; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        Run(arguments, nullFd, environ);
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples;
+}
+
+/// @brief Measures the static initialization time in microseconds, as reported by the target.
+double MeasureStaticInitialization(const std::string &target, uint32_t runs)
+{
+    auto environment = std::vector<char *>();
+    for (auto variable = environ; *variable != nullptr; variable++)
+    {
+        environment.push_back(*variable);
+    }
+    auto reportVariable = std::string("WHISPARG_BENCH_REPORT_STATIC_INIT=1");
+    environment.push_back(const_cast<char *>(reportVariable.c_str()));
+    environment.push_back(nullptr);
+
+    auto samples = std::vector<double>();
+    for (auto i = uint32_t(0); i < runs; i++)
+    {
+        int fds[2];
+        if (pipe(fds) != 0)
+        {
+            throw std::runtime_error("Failed to create a pipe.");
+        }
+        Run({target, "--version"}, fds[1], environment.data());
+        close(fds[1]);
+
+        auto output = std::string();
+        char buffer[4096];
+        for (auto size = read(fds[0], buffer, sizeof(buffer)); size > 0; size = read(fds[0], buffer, sizeof(buffer)))
+        {
+            output.append(buffer, static_cast<std::size_t>(size));
+        }
+        close(fds[0]);
+
+        auto position = output.find("static-init-ns ");
+        if (position != std::string::npos)
+        {
+            samples.push_back(std::stod(output.substr(position + 15)) / 1000.0);
+        }
+    }
+    if (samples.empty())
+    {
+        return 0.0;
+    }
+    std::sort(samples.begin(), samples.end());
+    return Percentile(samples, 50);
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    try
+    {
+        auto parser = idofront::whisparg::WhispArg(argc, argv)
+                          .Description("Measures the startup time of WhispArg-based binaries.")
+                          .Name("StartupBenchmark");
+
+        auto targetsArgument = idofront::whisparg::Argument<std::string>::New('t', "targets")
+                                   .Description("Comma-separated paths of the binaries to measure.");
+        auto runsArgument = idofront::whisparg::Argument<uint32_t>::New('r', "runs")
+                                .Description("The number of spawns per binary and invocation.")
+                                .Default(2000)
+                                .Min(1);
+
+        auto targetsOpt = parser.Parse(targetsArgument).Value();
+        auto runs = parser.Parse(runsArgument).Value().value();
+        auto help = parser.Parse<idofront::whisparg::type::Flag>(idofront::whisparg::Help);
+        if (help.Value().value())
+        {
+            parser.ShowHelp();
+            return 0;
+        }
+        parser.Validate();
+        if (!targetsOpt.has_value())
+        {
+            throw idofront::whisparg::WhispArgException("Argument \"targets\" is required.");
+        }
+        auto targets = targetsOpt.value();
+
+        auto nullFd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+        if (nullFd < 0)
+        {
+            throw std::runtime_error(std::string("Failed to open /dev/null: ") + std::strerror(errno));
+        }
+        auto invocations = std::vector<std::tuple<std::string, std::vector<std::string>>>{
+            {"--help", {"--help"}},
+            {"--version", {"--version"}},
+            {"typical", {"--option-0", "42", "--option-1", "text", "--option-2"}},
+        };
+
+        std::cout << std::left << std::setw(40) << "target" << std::right << std::setw(12) << "size[B]"
+                  << std::setw(16) << "static-init[us]" << std::setw(12) << "invocation" << std::setw(12)
+                  << "min[us]" << std::setw(12) << "p50[us]" << std::setw(12) << "p99[us]"
+                  << "\n";
+
+        auto stream = std::istringstream(targets);
+        auto target = std::string();
+        while (std::getline(stream, target, ','))
+        {
+            auto size = std::filesystem::file_size(target);
+            auto staticInitialization = MeasureStaticInitialization(target, std::min(runs, uint32_t(100)));
+
+            for (const auto &invocation : invocations)
+            {
+                auto arguments = std::vector<std::string>{target};
+                const auto &extraArguments = std::get<1>(invocation);
+                arguments.insert(arguments.end(), extraArguments.begin(), extraArguments.end());
+                auto samples = MeasureLatency(arguments, runs, nullFd);
+
+                std::cout << std::left << std::setw(40) << std::filesystem::path(target).filename().string()
+                          << std::right << std::setw(12) << size << std::setw(16) << std::fixed
+                          << std::setprecision(1) << staticInitialization << std::setw(12) << std::get<0>(invocation)
+                          << std::setw(12) << samples.front() << std::setw(12) << Percentile(samples, 50)
+                          << std::setw(12) << Percentile(samples, 99) << "\n"
+                          << std::flush;
+            }
+        }
+        close(nullFd);
+    }
+    catch (const std::exception &e)
+    {
+        auto message = std::string("Error: ") + e.what() + "\n";
+        std::cerr << message << std::flush;
+        return 1;
+    }
+
+    return 0;
+}
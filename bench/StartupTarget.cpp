@@ -0,0 +1,124 @@
+/*
+ Copyright (c) 2024 idofront
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// A WhispArgExample-style tool used by StartupBenchmark. It is built once per option count, which is given by
+// WHISPARG_BENCH_OPTION_COUNT.
+
+#include <cstdlib>
+#include <ctime>
+#include <idofront/WhispArg.hpp>
+#include <iostream>
+
+#ifndef WHISPARG_BENCH_OPTION_COUNT
+#define WHISPARG_BENCH_OPTION_COUNT 1
+#endif
+
+namespace
+{
+timespec StaticInitializationStart;
+
+/// @brief Records the time before the other static initializers run.
+/// @note Constructors with a priority run before those without one.
+__attribute__((constructor(101))) void RecordStaticInitializationStart()
+{
+    clock_gettime(CLOCK_MONOTONIC, &StaticInitializationStart);
+}
+
+long long ElapsedNanoseconds(const timespec &from, const timespec &to)
+{
+    return (to.tv_sec - from.tv_sec) * 1000000000LL + (to.tv_nsec - from.tv_nsec);
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    timespec mainStart;
+    clock_gettime(CLOCK_MONOTONIC, &mainStart);
+    if (std::getenv("WHISPARG_BENCH_REPORT_STATIC_INIT") != nullptr)
+    {
+        std::cerr << "static-init-ns " << ElapsedNanoseconds(StaticInitializationStart, mainStart) << "\n";
+    }
+
+    try
+    {
+        auto parser = idofront::whisparg::WhispArg(argc, argv)
+                          .Description("A tool for measuring the startup time of WhispArg-based binaries.")
+                          .Name("StartupTarget")
+                          .Version("v0.0.0");
+
+        auto sum = uint64_t(0);
+        for (auto i = 0; i < WHISPARG_BENCH_OPTION_COUNT; i++)
+        {
+            auto name = "option-" + std::to_string(i);
+            switch (i % 3)
+            {
+            case 0:
+                sum += parser
+                           .Parse(idofront::whisparg::Argument<uint32_t>::New(name)
+                                      .Description("A numeric option of the benchmark.")
+                                      .Default(0))
+                           .Value()
+                           .value();
+                break;
+            case 1:
+                sum += parser
+                           .Parse(idofront::whisparg::Argument<std::string>::New(name)
+                                      .Description("A string option of the benchmark.")
+                                      .Default(""))
+                           .Value()
+                           .value()
+                           .size();
+                break;
+            default:
+                sum += parser
+                           .Parse(idofront::whisparg::Argument<idofront::whisparg::type::Flag>::New(name).Description(
+                               "A flag option of the benchmark."))
+                           .Value()
+                           .value();
+                break;
+            }
+        }
+
+        auto version = parser.Parse(
+            idofront::whisparg::Argument<idofront::whisparg::type::Flag>::New("version").Description("Show version."));
+        auto help = parser.Parse<idofront::whisparg::type::Flag>(idofront::whisparg::Help);
+        if (help.Value().value())
+        {
+            parser.ShowHelp();
+            return 0;
+        }
+        if (version.Value().value())
+        {
+            std::cout << "StartupTarget v0.0.0\n" << std::flush;
+            return 0;
+        }
+
+        std::cout << "Sum: " << sum << "\n" << std::flush;
+    }
+    catch (const std::exception &e)
+    {
+        auto message = std::string("Error: ") + e.what() + "\n";
+        std::cerr << message << std::flush;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,45 @@
+// libFuzzer harness for the automatic converters.
+
+#include <cstddef>
+#include <cstdint>
+#include <idofront/WhispArg.hpp>
+#include <string>
+
+using namespace idofront::whisparg;
+
+namespace
+{
+template <typename T> void Convert(const std::string &value)
+{
+    auto argument = Argument<T>::New("value");
+    try
+    {
+        (void)AutomaticConverter(argument)(value);
+    }
+    catch (const std::exception &)
+    {
+        // Rejecting a value is fine. Crashing, hanging or leaking is not.
+    }
+}
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, std::size_t size)
+{
+    auto value = std::string(reinterpret_cast<const char *>(data), size);
+
+    Convert<int8_t>(value);
+    Convert<int16_t>(value);
+    Convert<int32_t>(value);
+    Convert<int64_t>(value);
+    Convert<uint8_t>(value);
+    Convert<uint16_t>(value);
+    Convert<uint32_t>(value);
+    Convert<uint64_t>(value);
+    Convert<float>(value);
+    Convert<double>(value);
+    Convert<long double>(value);
+    Convert<std::string>(value);
+    Convert<bool>(value);
+    Convert<type::Flag>(value);
+    return 0;
+}
@@ -0,0 +1,35 @@
+// libFuzzer harness for the help renderer.
+
+#include <cstddef>
+#include <cstdint>
+#include <idofront/WhispArg.hpp>
+#include <sstream>
+#include <string>
+
+using namespace idofront::whisparg;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, std::size_t size)
+{
+    if (size < 1)
+    {
+        return 0;
+    }
+
+    // The first byte selects the width, and the rest is split into the name and descriptions.
+    auto width = std::size_t(data[0]);
+    auto text = std::string(reinterpret_cast<const char *>(data + 1), size - 1);
+    auto name = text.substr(0, text.size() / 4);
+    auto description = text.substr(text.size() / 4);
+
+    char program[] = "fuzz";
+    char *argv[] = {program, nullptr};
+    auto parser = WhispArg(1, argv).Description(description).Name(name);
+    parser.Parse(Argument<std::string>::New(name).Description(description));
+    parser.Parse(Argument<type::Flag>::New('f', "flag").Description(description));
+
+    auto output = std::ostringstream();
+    auto original = std::cout.rdbuf(output.rdbuf());
+    parser.ShowHelp(width);
+    std::cout.rdbuf(original);
+    return 0;
+}
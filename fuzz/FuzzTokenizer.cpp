@@ -0,0 +1,38 @@
+// libFuzzer harness for the tokenizer and the engines built on it.
+
+#include <cstddef>
+#include <cstdint>
+#include <idofront/WhispArg.hpp>
+#include <string_view>
+
+using namespace idofront::whisparg;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, std::size_t size)
+{
+    auto text = std::string_view(reinterpret_cast<const char *>(data), size);
+
+    auto tokens = Tokenize(text);
+
+    auto number = Argument<int32_t>::New('n', "number");
+    auto message = Argument<std::string>::New('m', "message").Default("");
+    auto verbose = Argument<type::Flag>::New('v', "verbose");
+    try
+    {
+        Parse(tokens, number);
+    }
+    catch (const WhispArgException &)
+    {
+    }
+
+    auto result = BatchParser().Add(number).Add(message).Add(verbose).Parse(text, 1);
+    (void)result.Diagnostics();
+
+    auto incremental = IncrementalParser().Add(number).Add(message).Add(verbose);
+    for (auto length = std::size_t(0); length <= text.size(); length += 1 + text.size() / 16)
+    {
+        incremental.Update(text.substr(0, length));
+        (void)incremental.Diagnostics();
+        (void)incremental.Candidates();
+    }
+    return 0;
+}
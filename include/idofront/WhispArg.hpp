@@ -22,19 +22,64 @@
 #ifndef IDOFRONT__ARGUMENT__PARSER_HPP
 #define IDOFRONT__ARGUMENT__PARSER_HPP
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
 #include <cctype>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <filesystem>
+#include <fstream>
 #include <functional>
+#include <initializer_list>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <locale>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <numeric>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#define IDOFRONT__WHISPARG__POSIX 1
+#include <cerrno>
+#include <dirent.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+#endif
+
 namespace idofront
 {
 namespace whisparg
@@ -103,592 +148,6290 @@ std::ostream &operator<<(std::ostream &os, const Flag &flag)
 
 const Flag Flag::True = Flag(true);
 const Flag Flag::False = Flag(false);
-} // namespace type
 
-/// @brief A class that defines command-line arguments and holds the parsing results.
-/// @tparam T The type of the command-line argument.
-template <typename T> class Argument
+/// @brief An IPv4 or IPv6 address, such as "10.0.0.1" or "2001:db8::1".
+/// @note Parsing does not allocate and never resolves host names.
+class IpAddress
 {
   public:
-    /// @brief Creates a command-line argument with a short name.
-    static Argument New(const char &shortName, const std::string &name)
+    constexpr IpAddress() : _IsV6(false), _Bytes{}
     {
-        return Argument(std::string(1, shortName), name);
     }
 
-    /// @brief Creates a command-line argument without a short name.
-    static Argument New(const std::string &name)
+    /// @brief Parses an address.
+    /// @note Throws WhispArgException if @c text is not an IPv4 or IPv6 address.
+    static IpAddress Parse(std::string_view text)
     {
-        return Argument(name);
+        auto address = IpAddress();
+        if (!TryParse(text, address))
+        {
+            throw WhispArgException("Invalid IP address \"" + std::string(text) + "\".");
+        }
+        return address;
     }
 
-    /// @brief Updates the value of a command-line argument.
-    /// @note New creates a command-line argument without a value.
-    ///       By using Update, you can assign a value to it.
-    static Argument Update(const Argument &argument, const std::optional<T> &value)
+    /// @brief Parses an address.
+    /// @return false if @c text is not an IPv4 or IPv6 address.
+    static bool TryParse(std::string_view text, IpAddress &address) noexcept
     {
-        auto updatedArgument = argument;
-        updatedArgument._Value = value;
-        return updatedArgument;
+        address = IpAddress();
+        if (text.find(':') == std::string_view::npos)
+        {
+            return ParseV4(text, address._Bytes.data());
+        }
+        address._IsV6 = true;
+        return ParseV6(text, address._Bytes.data());
     }
 
-    /// @brief Gets the name of the command-line argument.
-    std::string Name() const
+    /// @brief Checks whether the address is an IPv6 address.
+    bool IsV6() const
     {
-        return _Name;
+        return _IsV6;
     }
 
-    /// @brief Gets the short name of the command-line argument.
-    std::string ShortName() const
+    /// @brief Gets the address in network byte order. Only the first Size() bytes are used.
+    const std::array<uint8_t, 16> &Bytes() const
     {
-        return _ShortName;
+        return _Bytes;
     }
 
-    /// @brief Sets the description of the command-line argument.
-    Argument Description(const std::string &description)
+    /// @brief Gets the length of the address in bytes, which is 4 or 16.
+    std::size_t Size() const
     {
-        _Description = description;
-        return *this;
+        return _IsV6 ? 16 : 4;
     }
 
-    /// @brief Gets the description of the command-line argument.
-    std::string Description() const
+    /// @brief Formats the address, compressing the longest run of zeros of an IPv6 address.
+    std::string ToString() const
     {
-        return _Description;
+        auto text = std::string();
+        if (!_IsV6)
+        {
+            for (auto i = 0; i < 4; i++)
+            {
+                text += (i == 0 ? "" : ".") + std::to_string(_Bytes[i]);
+            }
+            return text;
+        }
+
+        uint16_t groups[8];
+        for (auto i = 0; i < 8; i++)
+        {
+            groups[i] = static_cast<uint16_t>(_Bytes[i * 2] << 8 | _Bytes[i * 2 + 1]);
+        }
+        auto zerosBegin = 8, zerosLength = 0;
+        for (auto i = 0; i < 8;)
+        {
+            auto j = i;
+            while (j < 8 && groups[j] == 0)
+            {
+                j++;
+            }
+            if (j - i > zerosLength && j - i > 1)
+            {
+                zerosBegin = i;
+                zerosLength = j - i;
+            }
+            i = j == i ? i + 1 : j;
+        }
+
+        const char *digits = "0123456789abcdef";
+        for (auto i = 0; i < 8; i++)
+        {
+            if (i == zerosBegin)
+            {
+                text += "::";
+                i += zerosLength - 1;
+                continue;
+            }
+            if (i != 0 && i != zerosBegin + zerosLength)
+            {
+                text += ':';
+            }
+            auto isLeading = true;
+            for (auto shift = 12; shift >= 0; shift -= 4)
+            {
+                auto digit = (groups[i] >> shift) & 0xf;
+                if (digit != 0 || !isLeading || shift == 0)
+                {
+                    text += digits[digit];
+                    isLeading = false;
+                }
+            }
+        }
+        return text;
     }
 
-    /// @brief Sets the default value for the command-line argument.
-    Argument Default(const T &defaultValue)
+#if defined(IDOFRONT__WHISPARG__POSIX)
+    /// @brief Writes the address and a port to a socket address.
+    /// @return The length of the socket address.
+    socklen_t ToSockaddr(sockaddr_storage &storage, uint16_t port = 0) const
     {
-        _DefaultValue = defaultValue;
-        return *this;
+        storage = sockaddr_storage();
+        if (_IsV6)
+        {
+            auto &address = reinterpret_cast<sockaddr_in6 &>(storage);
+            address.sin6_family = AF_INET6;
+            address.sin6_port = htons(port);
+            std::memcpy(&address.sin6_addr, _Bytes.data(), 16);
+            return sizeof(sockaddr_in6);
+        }
+        auto &address = reinterpret_cast<sockaddr_in &>(storage);
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        std::memcpy(&address.sin_addr, _Bytes.data(), 4);
+        return sizeof(sockaddr_in);
     }
+#endif
 
-    /// @brief Gets the default value of the command-line argument.
-    /// @note Returns std::nullopt if no default value is set.
-    std::optional<T> Default() const
+    bool operator==(const IpAddress &other) const
     {
-        return _DefaultValue;
+        return _IsV6 == other._IsV6 && _Bytes == other._Bytes;
     }
 
-    /// @brief Specifies whether the command-line argument is required.
-    Argument IsRequired(bool isRequired)
+    bool operator!=(const IpAddress &other) const
     {
-        _IsRequired = isRequired;
-        return *this;
+        return !(*this == other);
     }
 
-    /// @brief Checks whether the command-line argument is required.
-    bool IsRequired() const
+  private:
+    bool _IsV6;
+    std::array<uint8_t, 16> _Bytes;
+
+    /// @brief Parses a dotted-decimal IPv4 address into 4 bytes.
+    static bool ParseV4(std::string_view text, uint8_t *bytes) noexcept
     {
-        return _IsRequired;
+        auto position = std::size_t(0);
+        for (auto i = 0; i < 4; i++)
+        {
+            if (i != 0)
+            {
+                if (position >= text.size() || text[position] != '.')
+                {
+                    return false;
+                }
+                position++;
+            }
+            auto begin = position;
+            auto value = 0;
+            while (position < text.size() && position - begin < 3 && text[position] >= '0' && text[position] <= '9')
+            {
+                value = value * 10 + (text[position] - '0');
+                position++;
+            }
+            // Leading zeros are rejected, since some tools read them as octal.
+            if (position == begin || value > 255 || (text[begin] == '0' && position - begin > 1))
+            {
+                return false;
+            }
+            bytes[i] = static_cast<uint8_t>(value);
+        }
+        return position == text.size();
     }
 
-    /// @brief Gets the value of the command-line argument.
-    /// @note If the value is not set, Default() is returned.
-    std::optional<T> Value() const
+    /// @brief Parses an IPv6 address, which may end with an IPv4 address, into 16 bytes.
+    static bool ParseV6(std::string_view text, uint8_t *bytes) noexcept
     {
-        return this->_Value.has_value() ? this->_Value : this->Default();
+        auto groupCount = 0;
+        auto compressedAt = -1;
+        auto position = std::size_t(0);
+        if (text.substr(0, 2) == "::")
+        {
+            compressedAt = 0;
+            position = 2;
+        }
+        while (position < text.size())
+        {
+            if (groupCount == 8)
+            {
+                return false;
+            }
+            auto end = text.find(':', position);
+            auto group = text.substr(position, end == std::string_view::npos ? std::string_view::npos : end - position);
+            if (group.find('.') != std::string_view::npos)
+            {
+                // An IPv4 address takes the last two groups.
+                if (end != std::string_view::npos || groupCount > 6 || !ParseV4(group, bytes + groupCount * 2))
+                {
+                    return false;
+                }
+                groupCount += 2;
+                break;
+            }
+            if (group.empty() || group.size() > 4)
+            {
+                return false;
+            }
+            auto value = 0;
+            for (auto c : group)
+            {
+                auto digit = c >= '0' && c <= '9' ? c - '0'
+                             : c >= 'a' && c <= 'f' ? c - 'a' + 10
+                             : c >= 'A' && c <= 'F' ? c - 'A' + 10
+                                                    : -1;
+                if (digit < 0)
+                {
+                    return false;
+                }
+                value = value << 4 | digit;
+            }
+            bytes[groupCount * 2] = static_cast<uint8_t>(value >> 8);
+            bytes[groupCount * 2 + 1] = static_cast<uint8_t>(value);
+            groupCount++;
+
+            if (end == std::string_view::npos)
+            {
+                break;
+            }
+            position = end + 1;
+            if (position < text.size() && text[position] == ':')
+            {
+                if (compressedAt >= 0)
+                {
+                    return false;
+                }
+                compressedAt = groupCount;
+                position++;
+            }
+            else if (position == text.size())
+            {
+                return false;
+            }
+        }
+
+        if (compressedAt < 0)
+        {
+            return groupCount == 8;
+        }
+        if (groupCount == 8)
+        {
+            return false;
+        }
+        // Moves the groups after "::" to the end and fills the gap with zeros.
+        auto tailBytes = (groupCount - compressedAt) * 2;
+        std::memmove(bytes + 16 - tailBytes, bytes + compressedAt * 2, static_cast<std::size_t>(tailBytes));
+        std::memset(bytes + compressedAt * 2, 0, static_cast<std::size_t>(16 - tailBytes - compressedAt * 2));
+        return true;
     }
+};
 
-    /// @brief Converts the command-line argument’s value to a string for help display.
-    const std::string ToHelpString() const
+inline std::ostream &operator<<(std::ostream &os, const IpAddress &address)
+{
+    return os << address.ToString();
+}
+
+/// @brief A host and a port, such as "0.0.0.0:8080", "[::1]:443" or "example.com:80".
+/// @note An IPv6 address must be enclosed in brackets. Host names are kept as they are and never resolved.
+class Endpoint
+{
+  public:
+    Endpoint() : _Address(), _HostName(), _Port(0)
     {
-        auto upperCaseName = std::string(_Name);
-        std::transform(upperCaseName.begin(), upperCaseName.end(), upperCaseName.begin(),
-                       [](char const &c) { return std::toupper(c); });
+    }
 
-        std::stringstream ss;
-        ss << "  ";
-        if (!_ShortName.empty())
+    /// @brief Parses an endpoint.
+    /// @note Throws WhispArgException if @c text is not a valid endpoint.
+    static Endpoint Parse(std::string_view text)
+    {
+        auto fail = [&](const std::string &reason) {
+            return WhispArgException("Invalid endpoint \"" + std::string(text) + "\": " + reason);
+        };
+
+        auto colon = text.rfind(':');
+        if (colon == std::string_view::npos)
         {
-            ss << "-" << _ShortName << ", ";
+            throw fail("a port is required.");
         }
-        ss << "--" << _Name;
-        if constexpr (!std::is_same_v<T, type::Flag>)
+        auto host = text.substr(0, colon);
+        auto endpoint = Endpoint();
+        endpoint._Port = ParsePort(text.substr(colon + 1), fail);
+
+        if (!host.empty() && host.front() == '[')
         {
-            ss << " <" << upperCaseName << ">";
+            if (host.back() != ']' || !IpAddress::TryParse(host.substr(1, host.size() - 2), endpoint._Address) ||
+                !endpoint._Address.IsV6())
+            {
+                throw fail("invalid IPv6 address.");
+            }
+            return endpoint;
         }
-        ss << "\n";
-        ss << "    " << _Description;
-        if (_DefaultValue.has_value())
+        if (host.find(':') != std::string_view::npos)
         {
-            ss << " (Default: " << _DefaultValue.value() << ")";
+            throw fail("an IPv6 address must be enclosed in brackets.");
         }
-        return ss.str();
+        if (IpAddress::TryParse(host, endpoint._Address))
+        {
+            return endpoint;
+        }
+        if (host.empty() || !std::all_of(host.begin(), host.end(), [](char c) {
+                return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '.' || c == '_';
+            }))
+        {
+            throw fail("invalid host.");
+        }
+        endpoint._HostName = std::string(host);
+        return endpoint;
     }
 
-  private:
-    std::string _Name;
-    std::string _ShortName;
-    std::string _Description;
-    std::optional<T> _DefaultValue;
-    bool _IsRequired;
-    std::optional<T> _Value;
+    /// @brief Gets the host, which is a host name or an address without brackets.
+    std::string Host() const
+    {
+        return IsAddress() ? _Address.ToString() : _HostName;
+    }
 
-    Argument(const std::string &shortName, const std::string &name)
-        : _Name(name), _ShortName(shortName), _Description(), _DefaultValue(std::nullopt), _IsRequired(false)
+    /// @brief Checks whether the host is an IP address rather than a host name.
+    bool IsAddress() const
     {
-        if constexpr (std::is_same_v<T, type::Flag>)
-        {
-            Default(type::Flag::False);
-        }
+        return _HostName.empty();
     }
 
-    Argument(const std::string &name) : Argument("", name)
+    /// @brief Gets the address of the host.
+    /// @note Returns std::nullopt if the host is a host name.
+    std::optional<IpAddress> Address() const
     {
+        return IsAddress() ? std::optional<IpAddress>(_Address) : std::nullopt;
     }
-};
 
-/// @brief Parses command-line arguments.
-/// @tparam T The type of the command-line argument.
-/// @param argv A vector of command-line arguments.
-/// @param argument The definition of the command-line argument.
-/// @param converter A function that converts the command-line argument string into type T.
-/// @return The value of the command-line argument (wrapped in std::optional).
-template <typename T>
-std::optional<T> Parse(std::vector<std::string> argv, const Argument<T> &argument,
-                       std::function<T(const std::string &)> converter)
-{
-    std::size_t argc = argv.size();
+    /// @brief Gets the port.
+    uint16_t Port() const
+    {
+        return _Port;
+    }
 
-    auto argumentName = argument.Name();
-    auto actualValue = std::string();
+    /// @brief Formats the endpoint, enclosing an IPv6 address in brackets.
+    std::string ToString() const
+    {
+        auto host = Host();
+        return (IsAddress() && _Address.IsV6() ? "[" + host + "]" : host) + ":" + std::to_string(_Port);
+    }
 
-    auto isArgumentMatched = [](const Argument<T> &argument, const std::string &currentArgumentName) {
-        switch (currentArgumentName.size())
+#if defined(IDOFRONT__WHISPARG__POSIX)
+    /// @brief Writes the endpoint to a socket address.
+    /// @return The length of the socket address.
+    /// @note Throws WhispArgException if the host is a host name, which has to be resolved by the caller.
+    socklen_t ToSockaddr(sockaddr_storage &storage) const
+    {
+        if (!IsAddress())
         {
-        case 0:
-        case 1:
-            return false;
-        case 2:
-            if (argument.ShortName().empty())
-            {
-                return false;
-            }
-            return ("-" + argument.ShortName()) == currentArgumentName;
-        default:
-            return ("--" + argument.Name()) == currentArgumentName;
+            throw WhispArgException("Host \"" + _HostName + "\" is not an IP address.");
         }
-    };
+        return _Address.ToSockaddr(storage, _Port);
+    }
+#endif
 
-    for (auto i = std::size_t(0); i < argc; i++)
+  private:
+    IpAddress _Address;
+    std::string _HostName;
+    uint16_t _Port;
+
+    template <typename Fail> static uint16_t ParsePort(std::string_view text, Fail fail)
     {
-        if (argv[i][0] == '-')
+        auto port = 0u;
+        if (text.empty() || text.size() > 5)
+        {
+            throw fail("invalid port.");
+        }
+        for (auto c : text)
         {
-            auto currentArgumentName = std::string(argv[i]);
-            if (isArgumentMatched(argument, currentArgumentName))
+            if (c < '0' || c > '9')
             {
-                if (std::is_same_v<T, type::Flag>)
-                {
-                    actualValue = type::Flag::True.ToString();
-                }
-                else
-                {
-                    auto nextValueExists = (i + 1) < argc;
-                    if (nextValueExists)
-                    {
-                        actualValue = std::string(nextValueExists ? argv[++i] : "");
-                        continue;
-                    }
-                    else
-                    {
-                        throw WhispArgException("Argument \"" + argumentName + "\" requires a value.");
-                    }
-                }
+                throw fail("invalid port.");
             }
+            port = port * 10 + static_cast<unsigned>(c - '0');
         }
-    }
-
-    if (actualValue.empty())
-    {
-        if (argument.IsRequired())
+        if (port > 65535)
         {
-            throw WhispArgException("Argument \"" + argumentName + "\" is required.");
+            throw fail("invalid port.");
         }
-
-        return argument.Default();
+        return static_cast<uint16_t>(port);
     }
+};
 
-    try
+inline std::ostream &operator<<(std::ostream &os, const Endpoint &endpoint)
+{
+    return os << endpoint.ToString();
+}
+
+/// @brief An address range in CIDR notation, such as "10.0.0.0/8" or "2001:db8::/32".
+/// @note An address without a prefix length is a range of that single address.
+class Cidr
+{
+  public:
+    Cidr() : _Address(), _PrefixLength(32)
     {
-        return converter(actualValue);
     }
-    catch (const std::exception &e)
+
+    /// @brief Parses a range.
+    /// @note Throws WhispArgException if @c text is not a valid range or has bits set after the prefix.
+    static Cidr Parse(std::string_view text)
     {
-        throw WhispArgException("Failed to parse the argument \"" + argumentName + "\": " + e.what());
-    }
-}
+        auto fail = [&](const std::string &reason) {
+            return WhispArgException("Invalid CIDR \"" + std::string(text) + "\": " + reason);
+        };
 
-/// @brief Parses command-line arguments.
-/// @tparam T The type of the command-line argument.
-/// @param argc The number of command-line arguments.
-/// @param argv The command-line arguments.
-/// @param argument The definition of the command-line argument.
-/// @param converter A function that converts the command-line argument string to type T.
-/// @return The value of the command-line argument (wrapped in std::optional).
-template <typename T>
-std::optional<T> Parse(int argc, char *argv[], const Argument<T> &argument,
-                       std::function<T(const std::string &)> converter)
+        auto slash = text.find('/');
+        auto cidr = Cidr();
+        if (!IpAddress::TryParse(text.substr(0, slash), cidr._Address))
+        {
+            throw fail("invalid address.");
+        }
+        auto maxLength = static_cast<int>(cidr._Address.Size() * 8);
+        cidr._PrefixLength = static_cast<uint8_t>(maxLength);
+        if (slash != std::string_view::npos)
+        {
+            auto length = text.substr(slash + 1);
+            auto value = 0;
+            if (length.empty() || length.size() > 3 ||
+                !std::all_of(length.begin(), length.end(), [](char c) { return c >= '0' && c <= '9'; }))
+            {
+                throw fail("invalid prefix length.");
+            }
+            for (auto c : length)
+            {
+                value = value * 10 + (c - '0');
+            }
+            if (value > maxLength)
+            {
+                throw fail("invalid prefix length.");
+            }
+            cidr._PrefixLength = static_cast<uint8_t>(value);
+        }
+        if (cidr.Masked(cidr._Address) != cidr._Address.Bytes())
+        {
+            throw fail("bits are set after the prefix.");
+        }
+        return cidr;
+    }
+
+    /// @brief Gets the first address of the range.
+    const IpAddress &Address() const
+    {
+        return _Address;
+    }
+
+    /// @brief Gets the number of leading bits that are fixed.
+    uint8_t PrefixLength() const
+    {
+        return _PrefixLength;
+    }
+
+    /// @brief Checks whether an address is in the range.
+    /// @note An IPv4 address is never in an IPv6 range, and vice versa.
+    bool Contains(const IpAddress &address) const
+    {
+        return address.IsV6() == _Address.IsV6() && Masked(address) == _Address.Bytes();
+    }
+
+    /// @brief Formats the range.
+    std::string ToString() const
+    {
+        return _Address.ToString() + "/" + std::to_string(_PrefixLength);
+    }
+
+  private:
+    IpAddress _Address;
+    uint8_t _PrefixLength;
+
+    std::array<uint8_t, 16> Masked(const IpAddress &address) const
+    {
+        auto bytes = address.Bytes();
+        for (auto i = std::size_t(0); i < bytes.size(); i++)
+        {
+            auto bits = static_cast<int>(_PrefixLength) - static_cast<int>(i) * 8;
+            bytes[i] &= bits >= 8 ? 0xff : bits <= 0 ? 0 : static_cast<uint8_t>(0xff << (8 - bits));
+        }
+        return bytes;
+    }
+};
+
+inline std::ostream &operator<<(std::ostream &os, const Cidr &cidr)
 {
-    return Parse(std::vector<std::string>(argv, argv + argc), argument, converter);
+    return os << cidr.ToString();
+}
+
+/// @brief A point in time given in ISO 8601 / RFC 3339 form or relative to the current time.
+/// @note Accepted forms are "2026-10-01" (midnight UTC), "2026-10-01T12:34:56Z",
+///       "2026-10-01T12:34:56.789+09:00", "now", and "now-2h" or "now+30m" with a unit of s, m, h, d or w.
+///       A date and time must have "Z" or an offset, so that the value does not depend on the local time zone.
+class Timestamp
+{
+  public:
+    using Clock = std::chrono::system_clock;
+
+    Timestamp() : _TimePoint()
+    {
+    }
+
+    explicit Timestamp(Clock::time_point timePoint) : _TimePoint(timePoint)
+    {
+    }
+
+    /// @brief Parses a timestamp, reading the current time for a relative form.
+    static Timestamp Parse(std::string_view text)
+    {
+        return Parse(text, Clock::now());
+    }
+
+    /// @brief Parses a timestamp.
+    /// @param now The time that a relative form is relative to.
+    /// @note Throws WhispArgException if @c text is not a valid timestamp.
+    static Timestamp Parse(std::string_view text, Clock::time_point now)
+    {
+        auto timestamp = Timestamp();
+        if (!TryParse(text, now, timestamp))
+        {
+            throw WhispArgException("Invalid timestamp \"" + std::string(text) +
+                                    "\". Use a form such as 2026-10-01T00:00:00Z or now-2h.");
+        }
+        return timestamp;
+    }
+
+    /// @brief Gets the point in time.
+    Clock::time_point TimePoint() const
+    {
+        return _TimePoint;
+    }
+
+    /// @brief Formats the timestamp in UTC, such as "2026-10-01T12:34:56.789Z".
+    std::string ToString() const
+    {
+        auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(_TimePoint.time_since_epoch()).count();
+        auto days = nanoseconds / NanosecondsPerDay - (nanoseconds % NanosecondsPerDay < 0 ? 1 : 0);
+        auto nanosecondOfDay = nanoseconds - days * NanosecondsPerDay;
+
+        // Converts days since 1970-01-01 to a civil date (http://howardhinnant.github.io/date_algorithms.html).
+        auto z = days + 719468;
+        auto era = (z >= 0 ? z : z - 146096) / 146097;
+        auto dayOfEra = z - era * 146097;
+        auto yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        auto dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        auto shiftedMonth = (5 * dayOfYear + 2) / 153;
+        auto day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+        auto month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+        auto year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+
+        auto second = nanosecondOfDay / 1000000000;
+        auto fraction = nanosecondOfDay % 1000000000;
+        char buffer[40];
+        auto length = std::snprintf(buffer, sizeof(buffer), "%04lld-%02lld-%02lldT%02lld:%02lld:%02lld",
+                                    static_cast<long long>(year), static_cast<long long>(month),
+                                    static_cast<long long>(day), static_cast<long long>(second / 3600),
+                                    static_cast<long long>(second / 60 % 60), static_cast<long long>(second % 60));
+        auto text = std::string(buffer, static_cast<std::size_t>(length));
+        if (fraction != 0)
+        {
+            std::snprintf(buffer, sizeof(buffer), ".%09lld", static_cast<long long>(fraction));
+            auto digits = std::string(buffer);
+            digits.erase(digits.find_last_not_of('0') + 1);
+            text += digits;
+        }
+        return text + "Z";
+    }
+
+    bool operator==(const Timestamp &other) const
+    {
+        return _TimePoint == other._TimePoint;
+    }
+
+    bool operator!=(const Timestamp &other) const
+    {
+        return _TimePoint != other._TimePoint;
+    }
+
+    bool operator<(const Timestamp &other) const
+    {
+        return _TimePoint < other._TimePoint;
+    }
+
+  private:
+    static constexpr int64_t NanosecondsPerDay = 86400LL * 1000000000LL;
+
+    Clock::time_point _TimePoint;
+
+    static bool TryParse(std::string_view text, Clock::time_point now, Timestamp &timestamp)
+    {
+        if (text.substr(0, 3) == "now")
+        {
+            return ParseRelative(text.substr(3), now, timestamp);
+        }
+
+        // The fields are at fixed positions: YYYY-MM-DD[THH:MM:SS[.fraction](Z|+HH:MM|-HH:MM)]
+        auto position = std::size_t(0);
+        auto year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+        if (!ReadDigits(text, position, 4, year) || !Expect(text, position, '-') ||
+            !ReadDigits(text, position, 2, month) || !Expect(text, position, '-') ||
+            !ReadDigits(text, position, 2, day))
+        {
+            return false;
+        }
+        if (month < 1 || month > 12 || day < 1 || day > DaysInMonth(year, month))
+        {
+            return false;
+        }
+
+        auto nanoseconds = int64_t(0);
+        auto offsetMinutes = 0;
+        if (position < text.size())
+        {
+            auto separator = text[position++];
+            if ((separator != 'T' && separator != 't' && separator != ' ') || !ReadDigits(text, position, 2, hour) ||
+                !Expect(text, position, ':') || !ReadDigits(text, position, 2, minute) ||
+                !Expect(text, position, ':') || !ReadDigits(text, position, 2, second))
+            {
+                return false;
+            }
+            // A leap second (60) is accepted and counted as the first second of the next minute.
+            if (hour > 23 || minute > 59 || second > 60)
+            {
+                return false;
+            }
+
+            if (position < text.size() && (text[position] == '.' || text[position] == ','))
+            {
+                position++;
+                auto digitCount = 0;
+                for (; position < text.size() && text[position] >= '0' && text[position] <= '9'; position++)
+                {
+                    // Digits beyond nanoseconds are ignored.
+                    if (digitCount++ < 9)
+                    {
+                        nanoseconds = nanoseconds * 10 + (text[position] - '0');
+                    }
+                }
+                if (digitCount == 0)
+                {
+                    return false;
+                }
+                for (; digitCount < 9; digitCount++)
+                {
+                    nanoseconds *= 10;
+                }
+            }
+
+            if (position >= text.size())
+            {
+                return false;
+            }
+            auto zone = text[position++];
+            if (zone == '+' || zone == '-')
+            {
+                auto offsetHour = 0, offsetMinute = 0;
+                if (!ReadDigits(text, position, 2, offsetHour) || !Expect(text, position, ':') ||
+                    !ReadDigits(text, position, 2, offsetMinute) || offsetHour > 23 || offsetMinute > 59)
+                {
+                    return false;
+                }
+                offsetMinutes = (zone == '+' ? 1 : -1) * (offsetHour * 60 + offsetMinute);
+            }
+            else if (zone != 'Z' && zone != 'z')
+            {
+                return false;
+            }
+            if (position != text.size())
+            {
+                return false;
+            }
+        }
+
+        auto seconds = DaysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second -
+                       static_cast<int64_t>(offsetMinutes) * 60;
+        timestamp._TimePoint = Clock::time_point(ToDuration(text, seconds, nanoseconds));
+        return true;
+    }
+
+    /// @brief Parses "", "-2h" or "+30m" after "now".
+    static bool ParseRelative(std::string_view text, Clock::time_point now, Timestamp &timestamp)
+    {
+        if (text.empty())
+        {
+            timestamp._TimePoint = now;
+            return true;
+        }
+        if (text.size() < 3 || (text[0] != '-' && text[0] != '+'))
+        {
+            return false;
+        }
+
+        auto amount = int64_t(0);
+        for (auto c : text.substr(1, text.size() - 2))
+        {
+            if (c < '0' || c > '9' || amount > std::numeric_limits<int64_t>::max() / 10 / 604800)
+            {
+                return false;
+            }
+            amount = amount * 10 + (c - '0');
+        }
+        auto unit = int64_t(0);
+        switch (text.back())
+        {
+        case 's':
+            unit = 1;
+            break;
+        case 'm':
+            unit = 60;
+            break;
+        case 'h':
+            unit = 3600;
+            break;
+        case 'd':
+            unit = 86400;
+            break;
+        case 'w':
+            unit = 604800;
+            break;
+        default:
+            return false;
+        }
+
+        auto description = "now" + std::string(text);
+        auto offset = ToDuration(description, amount * unit, 0);
+        auto sinceEpoch = now.time_since_epoch();
+        auto isInRange = text[0] == '-' ? sinceEpoch >= Clock::duration::min() + offset
+                                        : sinceEpoch <= Clock::duration::max() - offset;
+        if (!isInRange)
+        {
+            ThrowOutOfRange(description);
+        }
+        timestamp._TimePoint = text[0] == '-' ? now - offset : now + offset;
+        return true;
+    }
+
+    /// @brief Converts seconds and a non-negative number of nanoseconds to a Clock::duration.
+    /// @note Throws WhispArgException if the sum does not fit, instead of letting the conversion overflow.
+    static Clock::duration ToDuration(std::string_view text, int64_t seconds, int64_t nanoseconds)
+    {
+        // The whole seconds at either end are excluded, so that adding the fraction cannot overflow either.
+        static const auto MaxSeconds = std::chrono::duration_cast<std::chrono::seconds>(Clock::duration::max()).count();
+        static const auto MinSeconds = std::chrono::duration_cast<std::chrono::seconds>(Clock::duration::min()).count();
+        if (seconds >= MaxSeconds || seconds <= MinSeconds)
+        {
+            ThrowOutOfRange(text);
+        }
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(seconds)) +
+               std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(nanoseconds));
+    }
+
+    [[noreturn]] static void ThrowOutOfRange(std::string_view text)
+    {
+        throw WhispArgException("Timestamp \"" + std::string(text) +
+                                "\" is outside the range that the system clock can represent.");
+    }
+
+    static bool ReadDigits(std::string_view text, std::size_t &position, std::size_t count, int &value)
+    {
+        if (position + count > text.size())
+        {
+            return false;
+        }
+        value = 0;
+        for (auto end = position + count; position < end; position++)
+        {
+            if (text[position] < '0' || text[position] > '9')
+            {
+                return false;
+            }
+            value = value * 10 + (text[position] - '0');
+        }
+        return true;
+    }
+
+    static bool Expect(std::string_view text, std::size_t &position, char c)
+    {
+        if (position >= text.size() || text[position] != c)
+        {
+            return false;
+        }
+        position++;
+        return true;
+    }
+
+    static int DaysInMonth(int year, int month)
+    {
+        static constexpr int Days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        auto isLeapYear = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        return month == 2 && isLeapYear ? 29 : Days[month - 1];
+    }
+
+    /// @brief Converts a civil date to days since 1970-01-01 (http://howardhinnant.github.io/date_algorithms.html).
+    static int64_t DaysFromCivil(int64_t year, int64_t month, int64_t day)
+    {
+        year -= month <= 2 ? 1 : 0;
+        auto era = (year >= 0 ? year : year - 399) / 400;
+        auto yearOfEra = year - era * 400;
+        auto dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        auto dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+};
+
+inline std::ostream &operator<<(std::ostream &os, const Timestamp &timestamp)
+{
+    return os << timestamp.ToString();
 }
 
-/// @brief Parses command-line arguments for types that support automatic conversion.
-/// @tparam T The type of the command-line argument.
-/// @param argv A vector of command-line arguments.
-/// @param argument The definition of the command-line argument.
-/// @return The value of the command-line argument (wrapped in std::optional).
-/// @note Ensures at compile time that the type is supported.
-template <typename T> std::optional<T> Parse(std::vector<std::string> argv, const Argument<T> &argument)
-{
-    static_assert(std::is_same_v<T, int8_t> || std::is_same_v<T, int16_t> || std::is_same_v<T, int32_t> ||
-                      std::is_same_v<T, int64_t> || std::is_same_v<T, uint8_t> || std::is_same_v<T, uint16_t> ||
-                      std::is_same_v<T, uint32_t> || std::is_same_v<T, uint64_t> || std::is_same_v<T, float> ||
-                      std::is_same_v<T, double> || std::is_same_v<T, long double> || std::is_same_v<T, std::string> ||
-                      std::is_same_v<T, bool> || std::is_same_v<T, type::Flag>,
-                  "Type not supported automatically. Please provide a converter function.");
+/// @brief A path pattern such as "/data/2026-*/part-*.parquet", expanded by the program instead of the shell.
+/// @note Each path segment may contain '*', '?', character classes such as "[a-z]" or "[!0-9]", and '\' escapes.
+///       As with glob(3), a wildcard does not match a leading '.' of a name, and "**" is not recursive.
+///       The pattern is compiled once by Parse(), and Expand() walks the matching directories concurrently.
+class Glob
+{
+  public:
+    /// @brief Options of Expand().
+    struct Options
+    {
+        /// @brief The number of threads that walk directories. 0 uses one per hardware thread.
+        std::size_t Threads = 0;
+        /// @brief Whether the matches are reported in sorted order, after the walk has finished.
+        bool IsSorted = false;
+    };
+
+    Glob() = default;
+
+    /// @brief Compiles a pattern.
+    static Glob Parse(std::string_view pattern)
+    {
+        if (pattern.empty())
+        {
+            throw WhispArgException("Glob pattern must not be empty.");
+        }
+
+        auto glob = Glob();
+        glob._Pattern = std::string(pattern);
+        if (pattern.front() == '/')
+        {
+            glob._Root = "/";
+        }
+        auto isInRoot = true;
+        auto position = std::size_t(0);
+        while (position < pattern.size())
+        {
+            auto end = std::min(pattern.find('/', position), pattern.size());
+            auto text = pattern.substr(position, end - position);
+            position = end + 1;
+            if (text.empty())
+            {
+                continue;
+            }
+
+            auto segment = Compile(text);
+            if (isInRoot && segment.IsLiteral && position < pattern.size())
+            {
+                // Leading directories without wildcards are not listed.
+                glob._Root = Join(glob._Root, segment.Literal);
+                continue;
+            }
+            isInRoot = false;
+            glob._Segments.push_back(std::move(segment));
+        }
+        return glob;
+    }
+
+    /// @brief Gets the pattern.
+    const std::string &Pattern() const
+    {
+        return _Pattern;
+    }
+
+    /// @brief Checks whether a path matches the pattern, without accessing the file system.
+    bool Matches(std::string_view path) const
+    {
+        auto root = _Root;
+        if (!root.empty())
+        {
+            if (root != "/")
+            {
+                root += '/';
+            }
+            if (path.substr(0, root.size()) != root)
+            {
+                return false;
+            }
+            path.remove_prefix(root.size());
+        }
+        for (auto i = std::size_t(0); i < _Segments.size(); i++)
+        {
+            auto end = std::min(path.find('/'), path.size());
+            if (!MatchSegment(_Segments[i], path.substr(0, end)))
+            {
+                return false;
+            }
+            path.remove_prefix(std::min(end + 1, path.size()));
+            if (path.empty() != (i + 1 == _Segments.size()))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief Finds the paths that match the pattern.
+    /// @param callback Called once per match. Calls are not concurrent, but may come from a worker thread.
+    /// @note Matches are streamed as they are found unless Options::IsSorted is set. Directories that cannot be read
+    ///       are skipped. Throws the first exception thrown by @c callback, after the walk has stopped.
+    void Expand(const std::function<void(const std::string &)> &callback, Options options) const
+    {
+        auto matches = std::vector<std::string>();
+        auto mutex = std::mutex();
+        auto error = std::exception_ptr();
+        auto report = [&](std::string path) {
+            auto lock = std::lock_guard<std::mutex>(mutex);
+            if (error)
+            {
+                return;
+            }
+            if (options.IsSorted)
+            {
+                matches.push_back(std::move(path));
+                return;
+            }
+            try
+            {
+                callback(path);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+        };
+
+        Walk(report, options.Threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : options.Threads,
+             [&]() {
+                 auto lock = std::lock_guard<std::mutex>(mutex);
+                 return static_cast<bool>(error);
+             });
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+        if (options.IsSorted)
+        {
+            std::sort(matches.begin(), matches.end());
+            std::for_each(matches.begin(), matches.end(), callback);
+        }
+    }
+
+    /// @brief Finds the paths that match the pattern, streaming them as they are found.
+    void Expand(const std::function<void(const std::string &)> &callback) const
+    {
+        Expand(callback, Options());
+    }
+
+    /// @brief Finds the paths that match the pattern, in sorted order.
+    std::vector<std::string> Expand(std::size_t threads = 0) const
+    {
+        auto matches = std::vector<std::string>();
+        auto options = Options();
+        options.Threads = threads;
+        options.IsSorted = true;
+        Expand([&](const std::string &path) { matches.push_back(path); }, options);
+        return matches;
+    }
+
+  private:
+    /// @brief One element of a compiled segment.
+    struct Token
+    {
+        enum class Kind
+        {
+            Character,
+            AnyCharacter,
+            AnyString,
+            Class,
+        };
+        Kind Type;
+        char Character;
+        /// @brief The bytes that a class matches.
+        std::array<bool, 256> Members;
+    };
+
+    /// @brief A compiled path segment.
+    struct Segment
+    {
+        bool IsLiteral;
+        /// @brief The segment without escapes, if it has no wildcards.
+        std::string Literal;
+        std::vector<Token> Tokens;
+    };
+
+    /// @brief A directory to list and the index of the segment its entries are matched against.
+    struct Task
+    {
+        std::string Directory;
+        std::size_t Index;
+    };
+
+    enum class EntryType
+    {
+        Directory,
+        Other,
+        Unknown,
+    };
+
+    std::string _Pattern;
+    /// @brief The leading directories without wildcards, or an empty string for the current directory.
+    std::string _Root;
+    std::vector<Segment> _Segments;
+
+    static std::string Join(const std::string &directory, std::string_view name)
+    {
+        if (directory.empty())
+        {
+            return std::string(name);
+        }
+        return directory + (directory.back() == '/' ? "" : "/") + std::string(name);
+    }
+
+    static Segment Compile(std::string_view text)
+    {
+        auto segment = Segment{true, std::string(), std::vector<Token>()};
+        for (auto i = std::size_t(0); i < text.size(); i++)
+        {
+            auto token = Token{Token::Kind::Character, text[i], {}};
+            if (text[i] == '\\' && i + 1 < text.size())
+            {
+                token.Character = text[++i];
+            }
+            else if (text[i] == '*')
+            {
+                token.Type = Token::Kind::AnyString;
+            }
+            else if (text[i] == '?')
+            {
+                token.Type = Token::Kind::AnyCharacter;
+            }
+            else if (text[i] == '[')
+            {
+                // A class without a closing ']' is a literal '['.
+                auto j = i + 1;
+                auto isNegated = j < text.size() && (text[j] == '!' || text[j] == '^');
+                j += isNegated ? 1 : 0;
+                auto first = j;
+                while (j < text.size() && (text[j] != ']' || j == first))
+                {
+                    j++;
+                }
+                if (j < text.size())
+                {
+                    token.Type = Token::Kind::Class;
+                    token.Members.fill(isNegated);
+                    for (auto k = first; k < j; k++)
+                    {
+                        auto low = static_cast<unsigned char>(text[k]);
+                        auto high = low;
+                        if (k + 2 < j && text[k + 1] == '-')
+                        {
+                            high = static_cast<unsigned char>(text[k + 2]);
+                            k += 2;
+                        }
+                        for (auto c = static_cast<unsigned>(low); c <= high; c++)
+                        {
+                            token.Members[c] = !isNegated;
+                        }
+                    }
+                    i = j;
+                }
+            }
+
+            if (token.Type != Token::Kind::Character)
+            {
+                segment.IsLiteral = false;
+            }
+            else
+            {
+                segment.Literal += token.Character;
+            }
+            segment.Tokens.push_back(token);
+        }
+        return segment;
+    }
+
+    /// @brief Matches a name against a segment, backtracking only to the last '*'.
+    static bool MatchSegment(const Segment &segment, std::string_view name)
+    {
+        if (segment.IsLiteral)
+        {
+            return segment.Literal == name;
+        }
+        if (!name.empty() && name.front() == '.' &&
+            (segment.Tokens.front().Type != Token::Kind::Character || segment.Tokens.front().Character != '.'))
+        {
+            return false;
+        }
+
+        const auto &tokens = segment.Tokens;
+        auto t = std::size_t(0), n = std::size_t(0);
+        auto starToken = std::string::npos, starName = std::size_t(0);
+        while (n < name.size())
+        {
+            if (t < tokens.size())
+            {
+                const auto &token = tokens[t];
+                auto c = static_cast<unsigned char>(name[n]);
+                if (token.Type == Token::Kind::AnyString)
+                {
+                    starToken = t++;
+                    starName = n;
+                    continue;
+                }
+                if ((token.Type == Token::Kind::Character && token.Character == name[n]) ||
+                    token.Type == Token::Kind::AnyCharacter ||
+                    (token.Type == Token::Kind::Class && token.Members[c]))
+                {
+                    t++;
+                    n++;
+                    continue;
+                }
+            }
+            if (starToken == std::string::npos)
+            {
+                return false;
+            }
+            t = starToken + 1;
+            n = ++starName;
+        }
+        while (t < tokens.size() && tokens[t].Type == Token::Kind::AnyString)
+        {
+            t++;
+        }
+        return t == tokens.size();
+    }
+
+    static bool IsDirectory(const std::string &path)
+    {
+        auto status = std::error_code();
+        return std::filesystem::is_directory(path, status);
+    }
+
+    static bool Exists(const std::string &path)
+    {
+        auto status = std::error_code();
+        return std::filesystem::exists(std::filesystem::symlink_status(path, status));
+    }
+
+    /// @brief Calls @c visit with the name and type of each entry of a directory, except "." and "..".
+    template <typename Visit> static void ListDirectory(const std::string &path, Visit visit)
+    {
+        auto directory = path.empty() ? std::string(".") : path;
+#if defined(__linux__)
+        // getdents64 reads many entries per system call and gives their types without a stat per entry.
+        auto fd = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return;
+        }
+        alignas(8) char buffer[32 * 1024];
+        while (true)
+        {
+            auto size = syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+            if (size <= 0)
+            {
+                break;
+            }
+            for (auto offset = long(0); offset < size;)
+            {
+                // struct linux_dirent64 { ino64_t d_ino; off64_t d_off; unsigned short d_reclen; unsigned char d_type;
+                //                         char d_name[]; }
+                auto entry = buffer + offset;
+                unsigned short length;
+                std::memcpy(&length, entry + 16, sizeof(length));
+                auto type = static_cast<unsigned char>(entry[18]);
+                auto name = std::string_view(entry + 19);
+                offset += length;
+                if (name != "." && name != "..")
+                {
+                    visit(name, type == DT_DIR   ? EntryType::Directory
+                                : type == DT_UNKNOWN || type == DT_LNK ? EntryType::Unknown
+                                                                       : EntryType::Other);
+                }
+            }
+        }
+        close(fd);
+#elif defined(IDOFRONT__WHISPARG__POSIX)
+        auto stream = opendir(directory.c_str());
+        if (stream == nullptr)
+        {
+            return;
+        }
+        for (auto entry = readdir(stream); entry != nullptr; entry = readdir(stream))
+        {
+            auto name = std::string_view(entry->d_name);
+            if (name != "." && name != "..")
+            {
+                visit(name, EntryType::Unknown);
+            }
+        }
+        closedir(stream);
+#else
+        auto status = std::error_code();
+        for (auto iterator = std::filesystem::directory_iterator(directory, status);
+             !status && iterator != std::filesystem::directory_iterator(); iterator.increment(status))
+        {
+            visit(iterator->path().filename().string(), EntryType::Unknown);
+        }
+#endif
+    }
+
+    /// @brief Processes one directory, reporting matches and returning the subdirectories to walk.
+    template <typename Report> void Process(const Task &task, Report &report, std::vector<Task> &children) const
+    {
+        // Segments without wildcards are appended without listing the directory.
+        auto directory = task.Directory;
+        auto index = task.Index;
+        while (index < _Segments.size() && _Segments[index].IsLiteral)
+        {
+            directory = Join(directory, _Segments[index].Literal);
+            index++;
+        }
+        if (index == _Segments.size())
+        {
+            if (Exists(directory))
+            {
+                report(directory);
+            }
+            return;
+        }
+
+        const auto &segment = _Segments[index];
+        auto isLast = index + 1 == _Segments.size();
+        ListDirectory(directory, [&](std::string_view name, EntryType type) {
+            if (!MatchSegment(segment, name))
+            {
+                return;
+            }
+            auto path = Join(directory, name);
+            if (isLast)
+            {
+                report(std::move(path));
+            }
+            else if (type == EntryType::Directory || (type == EntryType::Unknown && IsDirectory(path)))
+            {
+                children.push_back(Task{std::move(path), index + 1});
+            }
+        });
+    }
+
+    /// @brief Walks the directories with a pool of threads that steal work from each other.
+    /// @note Each thread takes tasks from the back of its own queue, which keeps the walk depth-first and the queue
+    ///       short, and steals from the front of the others when its queue is empty. A thread that finds no task
+    ///       sleeps until another thread queues one or the walk finishes.
+    template <typename Report, typename IsStopped>
+    void Walk(Report &report, std::size_t threadCount, IsStopped isStopped) const
+    {
+        if (_Segments.empty())
+        {
+            if (Exists(_Root))
+            {
+                report(_Root);
+            }
+            return;
+        }
+
+        struct Queue
+        {
+            std::mutex Mutex;
+            std::deque<Task> Tasks;
+        };
+        auto queues = std::vector<Queue>(threadCount);
+        queues[0].Tasks.push_back(Task{_Root, 0});
+        // Tasks that are queued or being processed. The walk finishes when this reaches 0.
+        auto pending = std::atomic<std::size_t>(1);
+        // Tasks that are queued, which idle threads wait for.
+        auto queued = std::atomic<std::size_t>(1);
+        auto idleMutex = std::mutex();
+        auto idle = std::condition_variable();
+        auto error = std::exception_ptr();
+        auto errorMutex = std::mutex();
+
+        auto work = [&](std::size_t self) {
+            auto children = std::vector<Task>();
+            while (pending.load() > 0)
+            {
+                auto task = std::optional<Task>();
+                for (auto i = std::size_t(0); i < threadCount && !task; i++)
+                {
+                    auto &queue = queues[(self + i) % threadCount];
+                    auto lock = std::lock_guard<std::mutex>(queue.Mutex);
+                    if (!queue.Tasks.empty())
+                    {
+                        if (i == 0)
+                        {
+                            task = std::move(queue.Tasks.back());
+                            queue.Tasks.pop_back();
+                        }
+                        else
+                        {
+                            task = std::move(queue.Tasks.front());
+                            queue.Tasks.pop_front();
+                        }
+                        queued--;
+                    }
+                }
+                if (!task)
+                {
+                    // The counters are changed before the notifying thread takes the mutex, so a wakeup is not lost.
+                    auto lock = std::unique_lock<std::mutex>(idleMutex);
+                    idle.wait(lock, [&]() { return pending.load() == 0 || queued.load() > 0; });
+                    continue;
+                }
+
+                children.clear();
+                try
+                {
+                    if (!isStopped())
+                    {
+                        Process(task.value(), report, children);
+                    }
+                }
+                catch (...)
+                {
+                    auto lock = std::lock_guard<std::mutex>(errorMutex);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                    children.clear();
+                }
+                if (!children.empty())
+                {
+                    pending += children.size();
+                    {
+                        auto lock = std::lock_guard<std::mutex>(queues[self].Mutex);
+                        std::move(children.begin(), children.end(), std::back_inserter(queues[self].Tasks));
+                    }
+                    queued += children.size();
+                    auto lock = std::lock_guard<std::mutex>(idleMutex);
+                    if (children.size() == 1)
+                    {
+                        idle.notify_one();
+                    }
+                    else
+                    {
+                        idle.notify_all();
+                    }
+                }
+                if (--pending == 0)
+                {
+                    auto lock = std::lock_guard<std::mutex>(idleMutex);
+                    idle.notify_all();
+                }
+            }
+        };
+
+        auto threads = std::vector<std::thread>();
+        for (auto i = std::size_t(1); i < threadCount; i++)
+        {
+            threads.emplace_back(work, i);
+        }
+        work(0);
+        std::for_each(threads.begin(), threads.end(), [](std::thread &thread) { thread.join(); });
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+inline std::ostream &operator<<(std::ostream &os, const Glob &glob)
+{
+    return os << glob.Pattern();
+}
+
+/// @brief A file that the program writes to, checked while the command line is validated.
+/// @note Parse() only records the path. WhispArg::Parse() then checks the file with the options of the argument, see
+///       Argument::OutputOptions(), and reports a file that cannot be created or already exists as a violation together
+///       with the other invalid arguments. The check does not change the file system: an existing file is opened
+///       without truncating it and a missing one is not created yet. The file is created, truncated and reserved by
+///       Commit(), which WhispArg::Validate() calls once there are no violations, and which Descriptor() calls if it
+///       has not been called yet. "-" is the standard output, which is never closed.
+///       Copies share the descriptor, which is closed when the last copy is destroyed.
+class OutputFile
+{
+  public:
+    /// @brief What to do when the file already exists.
+    enum class Overwrite
+    {
+        /// @brief Truncate the file.
+        Truncate,
+        /// @brief Keep the contents and write after them.
+        Append,
+        /// @brief Report the file as a violation.
+        Fail,
+    };
+
+    /// @brief How the file will be accessed, passed to posix_fadvise().
+    enum class Access
+    {
+        Normal,
+        Sequential,
+        Random,
+        /// @brief The data will be written once and not read back soon.
+        NoReuse,
+    };
+
+    /// @brief Options for opening the file.
+    struct Options
+    {
+        Overwrite OverwritePolicy = Overwrite::Truncate;
+        /// @brief The number of bytes to reserve with fallocate(), or 0 to reserve nothing.
+        /// @note The space is reserved without changing the size of the file, so a full disk is reported before
+        ///       anything is written.
+        uint64_t SizeHint = 0;
+        /// @brief Whether to bypass the page cache with O_DIRECT.
+        /// @note Writes must then be aligned to the logical block size of the device.
+        bool IsDirect = false;
+        Access AccessPattern = Access::Normal;
+        /// @brief The permissions of a created file, before the umask is applied.
+        unsigned Mode = 0644;
+    };
+
+    OutputFile() = default;
+
+    /// @brief Records the path of the file without opening it.
+    static OutputFile Parse(std::string_view path)
+    {
+        if (path.empty())
+        {
+            throw WhispArgException("Output path must not be empty.");
+        }
+        auto file = OutputFile();
+        file._Path = std::string(path);
+        return file;
+    }
+
+    /// @brief Gets the path of the file.
+    const std::string &Path() const
+    {
+        return _Path;
+    }
+
+    /// @brief Checks whether the file has been opened or checked.
+    bool IsOpen() const
+    {
+        return static_cast<bool>(_Handle);
+    }
+
+    /// @brief Gets the file descriptor, or -1 if the file has not been opened.
+    /// @note Calls Commit() first if the file has only been checked, so it may throw WhispArgException.
+    ///       Always -1 on platforms without POSIX file descriptors, where Open() only checks that the file can be
+    ///       written.
+    int Descriptor() const
+    {
+        if (!_Handle)
+        {
+            return -1;
+        }
+        Commit(*_Handle);
+        return _Handle->Descriptor;
+    }
+
+    /// @brief Opens or creates the file. Does nothing if it is already open.
+    /// @note Throws WhispArgException with the reason if the file cannot be opened or the space cannot be reserved.
+    void Open(const Options &options)
+    {
+        Check(options);
+        Commit();
+    }
+
+    /// @brief Checks that the file can be opened with @c options without changing it. Does nothing if it is already
+    ///        open or checked.
+    /// @note An existing file is opened without truncating it, and for a missing file only its directory is checked.
+    ///       Throws WhispArgException with the reason if the file cannot be opened.
+    void Check(const Options &options)
+    {
+        if (_Handle)
+        {
+            return;
+        }
+        if (_Path == "-")
+        {
+            _Handle = std::make_shared<Handle>(1, false, options);
+            return;
+        }
+
+#if defined(IDOFRONT__WHISPARG__POSIX)
+        struct stat status;
+        if (::stat(_Path.c_str(), &status) != 0)
+        {
+            auto error = errno;
+            if (error != ENOENT)
+            {
+                Fail(std::strerror(error));
+            }
+            // The file is created by Commit(), so only the directory that it will be created in is checked.
+            auto separator = _Path.find_last_of('/');
+            auto directory = separator == std::string::npos ? std::string(".")
+                             : separator == 0               ? std::string("/")
+                                                            : _Path.substr(0, separator);
+            if (::access(directory.c_str(), W_OK | X_OK) != 0)
+            {
+                Fail(std::strerror(errno));
+            }
+            _Handle = std::make_shared<Handle>(-1, true, options);
+            return;
+        }
+        if (options.OverwritePolicy == Overwrite::Fail)
+        {
+            Fail(std::strerror(EEXIST));
+        }
+
+        // The existing file is opened without O_TRUNC, so that nothing is lost if the command line turns out to be
+        // invalid.
+        auto fd = OpenDescriptor(O_WRONLY, options);
+        _Handle = std::make_shared<Handle>(fd, true, options);
+#else
+        auto status = std::error_code();
+        if (options.OverwritePolicy == Overwrite::Fail && std::filesystem::exists(_Path, status))
+        {
+            Fail("File exists");
+        }
+        _Handle = std::make_shared<Handle>(-1, false, options);
+#endif
+    }
+
+    /// @brief Creates, truncates and reserves the file as its options say. Does nothing if it has been committed.
+    /// @note Throws WhispArgException with the reason if the file has not been checked, cannot be created or the space
+    ///       cannot be reserved.
+    void Commit() const
+    {
+        if (!_Handle)
+        {
+            Fail("the file has not been opened");
+        }
+        Commit(*_Handle);
+    }
+
+    /// @brief Closes the file. Copies that share the descriptor keep it open until they are closed or destroyed.
+    void Close()
+    {
+        _Handle.reset();
+    }
+
+  private:
+    /// @brief Closes the descriptor when the last copy of the file is destroyed.
+    struct Handle
+    {
+        int Descriptor;
+        bool IsOwned;
+        Options FileOptions;
+        bool IsCommitted = false;
+
+        Handle(int descriptor, bool isOwned, const Options &options)
+            : Descriptor(descriptor), IsOwned(isOwned), FileOptions(options)
+        {
+        }
+
+        Handle(const Handle &) = delete;
+        Handle &operator=(const Handle &) = delete;
+
+        ~Handle()
+        {
+#if defined(IDOFRONT__WHISPARG__POSIX)
+            if (IsOwned && Descriptor >= 0)
+            {
+                ::close(Descriptor);
+            }
+#endif
+        }
+    };
+
+    std::string _Path;
+    std::shared_ptr<Handle> _Handle;
+
+    [[noreturn]] void Fail(const std::string &reason) const
+    {
+        throw WhispArgException("Cannot open \"" + _Path + "\" for writing: " + reason + ".");
+    }
+
+    void Commit(Handle &handle) const
+    {
+        if (handle.IsCommitted || _Path == "-")
+        {
+            return;
+        }
+        const auto &options = handle.FileOptions;
+
+#if defined(IDOFRONT__WHISPARG__POSIX)
+        if (handle.Descriptor < 0)
+        {
+            // O_EXCL also catches a file that has been created since Check().
+            auto exclusive = options.OverwritePolicy == Overwrite::Fail ? O_EXCL : 0;
+            handle.Descriptor = OpenDescriptor(O_WRONLY | O_CREAT | exclusive, options);
+        }
+        else if (options.OverwritePolicy == Overwrite::Truncate && ::ftruncate(handle.Descriptor, 0) != 0)
+        {
+            Fail(std::strerror(errno));
+        }
+
+        if (options.SizeHint > 0)
+        {
+            Reserve(handle.Descriptor, options);
+        }
+#if defined(POSIX_FADV_SEQUENTIAL)
+        auto advice = options.AccessPattern == Access::Sequential ? POSIX_FADV_SEQUENTIAL
+                      : options.AccessPattern == Access::Random   ? POSIX_FADV_RANDOM
+                      : options.AccessPattern == Access::NoReuse  ? POSIX_FADV_NOREUSE
+                                                                  : POSIX_FADV_NORMAL;
+        // The advice is only a hint, so a failure is not an error.
+        ::posix_fadvise(handle.Descriptor, 0, 0, advice);
+#endif
+#else
+        auto mode = std::ios::binary | (options.OverwritePolicy == Overwrite::Append ? std::ios::app : std::ios::trunc);
+        if (!std::ofstream(_Path, mode))
+        {
+            Fail("cannot be opened for writing");
+        }
+#endif
+        handle.IsCommitted = true;
+    }
+
+#if defined(IDOFRONT__WHISPARG__POSIX)
+    /// @brief Opens the file with @c flags and the flags that @c options add.
+    int OpenDescriptor(int flags, const Options &options) const
+    {
+        flags |= O_CLOEXEC | (options.OverwritePolicy == Overwrite::Append ? O_APPEND : 0);
+#if defined(O_DIRECT)
+        flags |= options.IsDirect ? O_DIRECT : 0;
+#endif
+        auto fd = ::open(_Path.c_str(), flags, static_cast<mode_t>(options.Mode));
+        if (fd < 0)
+        {
+            auto error = errno;
+            if (error == EINVAL && options.IsDirect)
+            {
+                Fail("the file system does not support O_DIRECT");
+            }
+            Fail(std::strerror(error));
+        }
+#if !defined(O_DIRECT) && defined(F_NOCACHE)
+        if (options.IsDirect)
+        {
+            ::fcntl(fd, F_NOCACHE, 1);
+        }
+#endif
+        return fd;
+    }
+
+    /// @brief Reserves SizeHint bytes after the current end of the file.
+    void Reserve(int fd, const Options &options) const
+    {
+        auto offset = off_t(0);
+        if (options.OverwritePolicy == Overwrite::Append)
+        {
+            struct stat status;
+            offset = ::fstat(fd, &status) == 0 ? status.st_size : 0;
+        }
+#if defined(__linux__)
+        // FALLOC_FL_KEEP_SIZE reserves the blocks but leaves the size alone, so appending writers are not affected.
+        auto result = ::fallocate(fd, FALLOC_FL_KEEP_SIZE, offset, static_cast<off_t>(options.SizeHint));
+        auto error = result == 0 ? 0 : errno;
+#elif defined(__APPLE__)
+        auto error = 0;
+#else
+        auto error = ::posix_fallocate(fd, offset, static_cast<off_t>(options.SizeHint));
+#endif
+        // File systems that cannot preallocate are written to without a reservation.
+        if (error != 0 && error != EOPNOTSUPP && error != ENOSYS && error != EINVAL)
+        {
+            Fail(std::string("cannot reserve ") + std::to_string(options.SizeHint) + " bytes: " + std::strerror(error));
+        }
+    }
+#endif
+};
+
+inline std::ostream &operator<<(std::ostream &os, const OutputFile &file)
+{
+    return os << file.Path();
+}
+
+/// @brief An absolute URL such as "https://user@host:8443/path?x=y#top", split as described in RFC 3986.
+/// @note Parse() validates the URL and records where each component starts and ends, so the accessors return views
+///       into the stored text without allocating. Percent-encoded components are returned as written and only decoded
+///       when Decode() or QueryParameter() is called.
+class Url
+{
+  public:
+    Url() = default;
+
+    /// @brief Parses an absolute URL.
+    /// @note Throws WhispArgException if @c text is not a valid URL.
+    static Url Parse(std::string_view text)
+    {
+        auto url = Url();
+        url._Text = std::string(text);
+        auto view = std::string_view(url._Text);
+        auto fail = [&](const std::string &reason) {
+            return WhispArgException("Invalid URL \"" + url._Text + "\": " + reason);
+        };
+        if (view.size() >= Absent)
+        {
+            throw fail("too long.");
+        }
+
+        // scheme ":" ["//" authority] path ["?" query] ["#" fragment]
+        auto colon = view.find(':');
+        if (colon == std::string_view::npos || colon == 0 || !std::isalpha(static_cast<unsigned char>(view[0])) ||
+            !std::all_of(view.begin(), view.begin() + colon, [](char c) {
+                return std::isalnum(static_cast<unsigned char>(c)) || c == '+' || c == '-' || c == '.';
+            }))
+        {
+            throw fail("a scheme is required.");
+        }
+        url._Scheme = Span{0, static_cast<uint32_t>(colon)};
+
+        auto fragment = view.find('#', colon);
+        auto end = fragment == std::string_view::npos ? view.size() : fragment;
+        if (fragment != std::string_view::npos)
+        {
+            url._Fragment =
+                Span{static_cast<uint32_t>(fragment + 1), static_cast<uint32_t>(view.size() - fragment - 1)};
+        }
+        auto query = view.substr(0, end).find('?', colon);
+        if (query != std::string_view::npos)
+        {
+            url._Query = Span{static_cast<uint32_t>(query + 1), static_cast<uint32_t>(end - query - 1)};
+            end = query;
+        }
+
+        auto position = colon + 1;
+        if (view.substr(position, 2) == "//")
+        {
+            position += 2;
+            auto authorityEnd = std::min(view.find('/', position), end);
+            url._Authority = Span{static_cast<uint32_t>(position), static_cast<uint32_t>(authorityEnd - position)};
+            url.ParseAuthority(fail);
+            position = authorityEnd;
+        }
+        url._Path = Span{static_cast<uint32_t>(position), static_cast<uint32_t>(end - position)};
+
+        for (auto i = colon + 1; i < view.size(); i++)
+        {
+            auto c = static_cast<unsigned char>(view[i]);
+            if (c <= ' ' || c >= 0x7f || c == '"' || c == '<' || c == '>' || c == '\\' || c == '^' || c == '`' ||
+                c == '{' || c == '|' || c == '}' || (c == '#' && i != fragment))
+            {
+                throw fail("invalid character at position " + std::to_string(i) + ".");
+            }
+            if (c == '%' && (i + 2 >= view.size() || !std::isxdigit(static_cast<unsigned char>(view[i + 1])) ||
+                             !std::isxdigit(static_cast<unsigned char>(view[i + 2]))))
+            {
+                throw fail("invalid percent-encoding at position " + std::to_string(i) + ".");
+            }
+        }
+        return url;
+    }
+
+    /// @brief Decodes percent-encoded octets, such as "%20" to " ".
+    /// @param isForm Whether '+' is decoded to a space, as in the query of a submitted form.
+    static std::string Decode(std::string_view text, bool isForm = false)
+    {
+        auto decoded = std::string();
+        decoded.reserve(text.size());
+        for (auto i = std::size_t(0); i < text.size(); i++)
+        {
+            if (text[i] == '%' && i + 2 < text.size() && std::isxdigit(static_cast<unsigned char>(text[i + 1])) &&
+                std::isxdigit(static_cast<unsigned char>(text[i + 2])))
+            {
+                decoded += static_cast<char>(HexValue(text[i + 1]) * 16 + HexValue(text[i + 2]));
+                i += 2;
+            }
+            else
+            {
+                decoded += isForm && text[i] == '+' ? ' ' : text[i];
+            }
+        }
+        return decoded;
+    }
+
+    /// @brief Gets the scheme, such as "https".
+    std::string_view Scheme() const
+    {
+        return View(_Scheme);
+    }
+
+    /// @brief Gets the authority, such as "user@host:8443", or an empty view if there is none.
+    std::string_view Authority() const
+    {
+        return View(_Authority);
+    }
+
+    /// @brief Gets the user information before '@' in the authority, still percent-encoded.
+    std::string_view UserInfo() const
+    {
+        return View(_UserInfo);
+    }
+
+    /// @brief Gets the host, which is a registered name, an IPv4 address or an IPv6 address without brackets.
+    std::string_view Host() const
+    {
+        return View(_Host);
+    }
+
+    /// @brief Gets the port, or std::nullopt if the authority has no port.
+    std::optional<uint16_t> Port() const
+    {
+        return _Port;
+    }
+
+    /// @brief Gets the path, still percent-encoded, such as "/a%20b".
+    std::string_view Path() const
+    {
+        return View(_Path);
+    }
+
+    /// @brief Gets the query after '?', still percent-encoded.
+    std::string_view Query() const
+    {
+        return View(_Query);
+    }
+
+    /// @brief Gets the fragment after '#', still percent-encoded.
+    std::string_view Fragment() const
+    {
+        return View(_Fragment);
+    }
+
+    /// @brief Checks whether the URL has an authority, which may be empty as in "file:///tmp".
+    bool HasAuthority() const
+    {
+        return _Authority.Offset != Absent;
+    }
+
+    /// @brief Checks whether the URL has a query, which may be empty as in "http://host/?".
+    bool HasQuery() const
+    {
+        return _Query.Offset != Absent;
+    }
+
+    /// @brief Checks whether the URL has a fragment.
+    bool HasFragment() const
+    {
+        return _Fragment.Offset != Absent;
+    }
+
+    /// @brief Finds a parameter of a query such as "x=1&y=a+b" and decodes its value.
+    /// @return The value of the first parameter named @c name, or std::nullopt if there is none.
+    std::optional<std::string> QueryParameter(std::string_view name) const
+    {
+        auto query = Query();
+        while (!query.empty())
+        {
+            auto separator = std::min(query.find('&'), query.size());
+            auto parameter = query.substr(0, separator);
+            query.remove_prefix(std::min(separator + 1, query.size()));
+
+            auto equals = std::min(parameter.find('='), parameter.size());
+            auto key = parameter.substr(0, equals);
+            // Keys without escapes are compared without decoding them.
+            if (key.find_first_of("%+") == std::string_view::npos ? key == name : Decode(key, true) == name)
+            {
+                return Decode(parameter.substr(std::min(equals + 1, parameter.size())), true);
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// @brief Gets the URL as given to Parse().
+    const std::string &ToString() const
+    {
+        return _Text;
+    }
+
+    bool operator==(const Url &other) const
+    {
+        return _Text == other._Text;
+    }
+
+    bool operator!=(const Url &other) const
+    {
+        return !(*this == other);
+    }
+
+  private:
+    static constexpr uint32_t Absent = std::numeric_limits<uint32_t>::max();
+
+    /// @brief The position of a component in _Text.
+    struct Span
+    {
+        uint32_t Offset = Absent;
+        uint32_t Length = 0;
+    };
+
+    std::string _Text;
+    Span _Scheme;
+    Span _Authority;
+    Span _UserInfo;
+    Span _Host;
+    Span _Path;
+    Span _Query;
+    Span _Fragment;
+    std::optional<uint16_t> _Port;
+
+    std::string_view View(const Span &span) const
+    {
+        return span.Offset == Absent ? std::string_view() : std::string_view(_Text).substr(span.Offset, span.Length);
+    }
+
+    static int HexValue(char c)
+    {
+        return std::isdigit(static_cast<unsigned char>(c)) ? c - '0'
+                                                           : std::tolower(static_cast<unsigned char>(c)) - 'a' + 10;
+    }
+
+    /// @brief Splits the authority into user information, host and port.
+    template <typename Fail> void ParseAuthority(Fail fail)
+    {
+        auto authority = View(_Authority);
+        auto offset = _Authority.Offset;
+        auto at = authority.rfind('@');
+        if (at != std::string_view::npos)
+        {
+            _UserInfo = Span{offset, static_cast<uint32_t>(at)};
+            offset += static_cast<uint32_t>(at + 1);
+            authority.remove_prefix(at + 1);
+        }
+
+        auto hostLength = authority.size();
+        if (!authority.empty() && authority.front() == '[')
+        {
+            auto close = authority.find(']');
+            auto address = IpAddress();
+            if (close == std::string_view::npos || !IpAddress::TryParse(authority.substr(1, close - 1), address) ||
+                !address.IsV6())
+            {
+                throw fail("invalid IPv6 address.");
+            }
+            _Host = Span{offset + 1, static_cast<uint32_t>(close - 1)};
+            hostLength = close + 1;
+        }
+        else
+        {
+            hostLength = std::min(authority.find(':'), authority.size());
+            _Host = Span{offset, static_cast<uint32_t>(hostLength)};
+        }
+
+        auto rest = authority.substr(hostLength);
+        if (rest.empty())
+        {
+            return;
+        }
+        if (rest.front() != ':')
+        {
+            throw fail("invalid host.");
+        }
+        rest.remove_prefix(1);
+        if (rest.empty())
+        {
+            return;
+        }
+        auto port = uint32_t(0);
+        for (auto c : rest)
+        {
+            if (!std::isdigit(static_cast<unsigned char>(c)) || (port = port * 10 + (c - '0')) > 65535)
+            {
+                throw fail("invalid port.");
+            }
+        }
+        _Port = static_cast<uint16_t>(port);
+    }
+};
+
+inline std::ostream &operator<<(std::ostream &os, const Url &url)
+{
+    return os << url.ToString();
+}
+
+/// @brief A comma-separated list of values, such as "a:1,b:2" for List<Endpoint>.
+/// @tparam T The type of the elements, which must support automatic conversion.
+template <typename T> class List : public std::vector<T>
+{
+  public:
+    using std::vector<T>::vector;
+};
+
+template <typename T> std::ostream &operator<<(std::ostream &os, const List<T> &list)
+{
+    for (auto i = std::size_t(0); i < list.size(); i++)
+    {
+        os << (i == 0 ? "" : ",") << list[i];
+    }
+    return os;
+}
+
+/// @brief Checks whether a type is a List.
+template <typename T> struct IsList : std::false_type
+{
+};
+
+template <typename T> struct IsList<List<T>> : std::true_type
+{
+};
+
+/// @brief An integer that must be in [Lo, Hi], such as Bounded<uint16_t, 1, 256> for a thread count.
+/// @note The limits are compile-time constants, so the converter checks them in place of the limits of T.
+template <typename T, T Lo, T Hi> class Bounded
+{
+    static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "Bounded requires an integer type.");
+    static_assert(Lo <= Hi, "The lower limit must not be greater than the upper limit.");
+
+  public:
+    using value_type = T;
+    static constexpr T Min = Lo;
+    static constexpr T Max = Hi;
+
+    constexpr Bounded() : _Value(Lo)
+    {
+    }
+
+    /// @brief Constructs a value.
+    /// @note Throws WhispArgException if @c value is out of range.
+    constexpr Bounded(T value) : _Value(value)
+    {
+        if (value < Lo || value > Hi)
+        {
+            throw WhispArgException("Value must be between " + std::to_string(+Lo) + " and " + std::to_string(+Hi) +
+                                    ".");
+        }
+    }
+
+    constexpr T Value() const
+    {
+        return _Value;
+    }
+
+    constexpr operator T() const
+    {
+        return _Value;
+    }
+
+  private:
+    T _Value;
+};
+
+template <typename T, T Lo, T Hi> std::ostream &operator<<(std::ostream &os, const Bounded<T, Lo, Hi> &value)
+{
+    return os << +value.Value();
+}
+
+/// @brief Checks whether a type is a Bounded.
+template <typename T> struct IsBounded : std::false_type
+{
+};
+
+template <typename T, T Lo, T Hi> struct IsBounded<Bounded<T, Lo, Hi>> : std::true_type
+{
+};
+} // namespace type
+
+/// @brief Finds the first byte of @c text that is not part of a well-formed UTF-8 sequence.
+/// @return The offset of the byte, or std::string::npos if @c text is valid UTF-8.
+/// @note Overlong encodings, surrogates and code points above U+10FFFF are invalid, as in RFC 3629.
+///       Runs of ASCII are skipped 32 bytes at a time with AVX2, 16 with SSE2 or 8 otherwise, and only the other
+///       sequences are decoded.
+inline std::size_t FindInvalidUtf8(std::string_view text)
+{
+    auto data = reinterpret_cast<const unsigned char *>(text.data());
+    auto size = text.size();
+    auto i = std::size_t(0);
+    while (i < size)
+    {
+#if defined(__AVX2__)
+        while (i + 32 <= size &&
+               _mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i))) == 0)
+        {
+            i += 32;
+        }
+#endif
+#if defined(__SSE2__)
+        while (i + 16 <= size && _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i))) == 0)
+        {
+            i += 16;
+        }
+#else
+        for (uint64_t block; i + 8 <= size && (std::memcpy(&block, data + i, 8), block & 0x8080808080808080) == 0;)
+        {
+            i += 8;
+        }
+#endif
+        if (i >= size)
+        {
+            break;
+        }
+
+        auto lead = data[i];
+        if (lead < 0x80)
+        {
+            i++;
+            continue;
+        }
+        // The valid range of the second byte depends on the lead byte, which rules out overlong encodings,
+        // surrogates and code points above U+10FFFF.
+        auto length = std::size_t(0);
+        auto low = 0x80, high = 0xBF;
+        if (lead >= 0xC2 && lead <= 0xDF)
+        {
+            length = 2;
+        }
+        else if (lead >= 0xE0 && lead <= 0xEF)
+        {
+            length = 3;
+            low = lead == 0xE0 ? 0xA0 : 0x80;
+            high = lead == 0xED ? 0x9F : 0xBF;
+        }
+        else if (lead >= 0xF0 && lead <= 0xF4)
+        {
+            length = 4;
+            low = lead == 0xF0 ? 0x90 : 0x80;
+            high = lead == 0xF4 ? 0x8F : 0xBF;
+        }
+        else
+        {
+            return i;
+        }
+        for (auto j = std::size_t(1); j < length; j++)
+        {
+            if (i + j >= size)
+            {
+                return i;
+            }
+            auto c = data[i + j];
+            if (c < (j == 1 ? low : 0x80) || c > (j == 1 ? high : 0xBF))
+            {
+                return i;
+            }
+        }
+        i += length;
+    }
+    return std::string::npos;
+}
+
+/// @brief Checks whether @c text is valid UTF-8.
+inline bool IsValidUtf8(std::string_view text)
+{
+    return FindInvalidUtf8(text) == std::string::npos;
+}
+
+/// @brief Counts the code points of UTF-8 text, which is the number of bytes that do not continue a sequence.
+/// @note Used as the display width of text. Each byte of invalid UTF-8 counts as one.
+inline std::size_t CountCodePoints(std::string_view text)
+{
+    return static_cast<std::size_t>(std::count_if(
+        text.begin(), text.end(), [](char c) { return (static_cast<unsigned char>(c) & 0xC0) != 0x80; }));
+}
+
+/// @brief Describes the first invalid byte of UTF-8 text for a message, such as "invalid byte 0xFF at offset 3".
+/// @return std::nullopt if @c text is valid UTF-8.
+inline std::optional<std::string> DescribeInvalidUtf8(std::string_view text)
+{
+    auto offset = FindInvalidUtf8(text);
+    if (offset == std::string::npos)
+    {
+        return std::nullopt;
+    }
+    char hex[8];
+    std::snprintf(hex, sizeof(hex), "0x%02X", static_cast<unsigned>(static_cast<unsigned char>(text[offset])));
+    return std::string("invalid byte ") + hex + " at offset " + std::to_string(offset);
+}
+
+/// @brief Escapes text for a JSON string literal, without the surrounding quotes.
+inline std::string EscapeJson(std::string_view text)
+{
+    auto escaped = std::string();
+    escaped.reserve(text.size());
+    for (auto c : text)
+    {
+        switch (c)
+        {
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        case '\r':
+            escaped += "\\r";
+            break;
+        case '\t':
+            escaped += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                const char *digits = "0123456789abcdef";
+                escaped += "\\u00";
+                escaped += digits[(c >> 4) & 0xf];
+                escaped += digits[c & 0xf];
+            }
+            else
+            {
+                escaped += c;
+            }
+        }
+    }
+    return escaped;
+}
+
+/// @brief Checks whether values of a type can be written to a std::ostream.
+template <typename T, typename = void> struct IsStreamable : std::false_type
+{
+};
+
+template <typename T>
+struct IsStreamable<T, std::void_t<decltype(std::declval<std::ostream &>() << std::declval<const T &>())>>
+    : std::true_type
+{
+};
+
+/// @brief Converts a value to a JSON value.
+/// @note Returns std::nullopt if the value cannot be written to a std::ostream.
+template <typename T> std::optional<std::string> ToJsonValue(const T &value)
+{
+    if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, type::Flag>)
+    {
+        return static_cast<bool>(value) ? "true" : "false";
+    }
+    else if constexpr (std::is_same_v<T, int8_t> || std::is_same_v<T, uint8_t>)
+    {
+        return std::to_string(static_cast<int>(value));
+    }
+    else if constexpr (type::IsBounded<T>::value)
+    {
+        return ToJsonValue(value.Value());
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        // JSON has no literal for NaN or the infinities.
+        if (!std::isfinite(value))
+        {
+            return "null";
+        }
+        // digits10 gives the short form of values such as 0.1, and max_digits10 is used if that does not read back
+        // as the same value.
+        auto write = [&value](int precision) {
+            std::ostringstream stream;
+            stream.imbue(std::locale::classic());
+            stream.precision(precision);
+            stream << value;
+            return stream.str();
+        };
+        auto text = write(std::numeric_limits<T>::digits10);
+        auto stream = std::istringstream(text);
+        stream.imbue(std::locale::classic());
+        auto readBack = T();
+        stream >> readBack;
+        return readBack == value ? text : write(std::numeric_limits<T>::max_digits10);
+    }
+    else if constexpr (std::is_arithmetic_v<T>)
+    {
+        std::ostringstream stream;
+        stream << value;
+        return stream.str();
+    }
+    else if constexpr (IsStreamable<T>::value)
+    {
+        std::ostringstream stream;
+        stream << value;
+        return "\"" + EscapeJson(stream.str()) + "\"";
+    }
+    else
+    {
+        return std::nullopt;
+    }
+}
+
+/// @brief Converts a value to text for messages.
+/// @note Returns an empty string if the value cannot be written to a std::ostream.
+template <typename T> std::string ToDisplayString(const T &value)
+{
+    if constexpr (std::is_same_v<T, int8_t> || std::is_same_v<T, uint8_t>)
+    {
+        return std::to_string(static_cast<int>(value));
+    }
+    else if constexpr (IsStreamable<T>::value)
+    {
+        std::ostringstream stream;
+        stream << value;
+        return stream.str();
+    }
+    else
+    {
+        return "";
+    }
+}
+
+/// @brief A regular expression compiled to a deterministic finite automaton, for validating string arguments.
+/// @note Supports literals, '.', character classes such as "[a-z0-9-]" or "[^,]", the escapes \d, \w, \s and their
+///       negations, grouping, '|', '*', '+', '?' and "{m}", "{m,}", "{m,n}". The whole value must match, so leading '^'
+///       and trailing '$' are accepted but not required. There are no captures, backreferences or lookarounds, so
+///       matching is a single table lookup per byte.
+class PatternMatcher
+{
+  public:
+    /// @brief Compiles a pattern, reusing the automaton of an identical pattern compiled before.
+    /// @note Compiled automatons are shared by all arguments of the process and are never released.
+    static std::shared_ptr<const PatternMatcher> Compile(const std::string &pattern)
+    {
+        static auto mutex = std::mutex();
+        static auto cache = std::unordered_map<std::string, std::shared_ptr<const PatternMatcher>>();
+
+        auto lock = std::lock_guard<std::mutex>(mutex);
+        auto found = cache.find(pattern);
+        if (found != cache.end())
+        {
+            return found->second;
+        }
+        auto matcher = std::shared_ptr<const PatternMatcher>(new PatternMatcher(pattern));
+        cache.emplace(pattern, matcher);
+        return matcher;
+    }
+
+    /// @brief Gets the pattern.
+    const std::string &Source() const
+    {
+        return _Source;
+    }
+
+    /// @brief Gets the number of states of the automaton.
+    std::size_t StateCount() const
+    {
+        return _IsAccepting.size();
+    }
+
+    /// @brief Checks whether the whole text matches the pattern.
+    bool Matches(std::string_view text) const
+    {
+        auto state = 0;
+        for (auto c : text)
+        {
+            state = _Transitions[state * _ClassCount + _Classes[static_cast<unsigned char>(c)]];
+            if (state < 0)
+            {
+                return false;
+            }
+        }
+        return _IsAccepting[state];
+    }
+
+  private:
+    using CharacterSet = std::bitset<256>;
+
+    /// @brief A node of the syntax tree.
+    struct Node
+    {
+        enum class Kind
+        {
+            Empty,
+            Set,
+            Concatenation,
+            Alternation,
+            Repetition,
+        };
+        Kind Type;
+        CharacterSet Set;
+        std::vector<Node> Children;
+        std::size_t Min;
+        /// @brief The maximum number of repetitions, or Unbounded.
+        std::size_t Max;
+    };
+
+    /// @brief A state of the nondeterministic automaton, which consumes a byte of @c Set or moves without consuming.
+    struct NfaState
+    {
+        CharacterSet Set;
+        int Next;
+        std::vector<int> Epsilon;
+    };
+
+    static constexpr std::size_t Unbounded = std::numeric_limits<std::size_t>::max();
+    static constexpr std::size_t MaxRepetitions = 1000;
+    static constexpr std::size_t MaxStates = 4096;
+
+    std::string _Source;
+    /// @brief The class of each byte. Bytes in the same class are not distinguished by any character set.
+    std::array<uint16_t, 256> _Classes;
+    std::size_t _ClassCount;
+    /// @brief The next state for each state and class, or -1 if the text cannot match any more.
+    std::vector<int> _Transitions;
+    std::vector<bool> _IsAccepting;
+
+    explicit PatternMatcher(const std::string &pattern) : _Source(pattern), _Classes(), _ClassCount(0)
+    {
+        auto text = std::string_view(pattern);
+        if (!text.empty() && text.front() == '^')
+        {
+            text.remove_prefix(1);
+        }
+        if (!text.empty() && text.back() == '$')
+        {
+            // The '$' is escaped only if it follows an odd number of backslashes, since "\\" is a literal backslash.
+            auto backslashes = std::size_t(0);
+            while (backslashes + 1 < text.size() && text[text.size() - 2 - backslashes] == '\\')
+            {
+                backslashes++;
+            }
+            if (backslashes % 2 == 0)
+            {
+                text.remove_suffix(1);
+            }
+        }
+
+        auto position = std::size_t(0);
+        auto tree = ParseAlternation(text, position);
+        if (position < text.size())
+        {
+            Fail(text[position] == ')' ? "unmatched ')'" : "unexpected character");
+        }
+
+        auto nfa = std::vector<NfaState>();
+        auto fragment = Build(tree, nfa);
+        BuildDfa(nfa, fragment.first, fragment.second);
+    }
+
+    [[noreturn]] void Fail(const std::string &reason) const
+    {
+        throw WhispArgException("Invalid pattern \"" + _Source + "\": " + reason + ".");
+    }
+
+    static Node Leaf(const CharacterSet &set)
+    {
+        return Node{Node::Kind::Set, set, {}, 0, 0};
+    }
+
+    static CharacterSet Single(char c)
+    {
+        auto set = CharacterSet();
+        set.set(static_cast<unsigned char>(c));
+        return set;
+    }
+
+    /// @brief Gets the set of a class escape such as "\d", or nullopt for an escaped literal.
+    static std::optional<CharacterSet> EscapeSet(char c)
+    {
+        auto set = CharacterSet();
+        auto lower = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        for (auto i = 0; i < 256; i++)
+        {
+            auto isMember = (lower == 'd' && std::isdigit(i)) || (lower == 'w' && (std::isalnum(i) || i == '_')) ||
+                            (lower == 's' && std::isspace(i));
+            set.set(static_cast<std::size_t>(i), isMember && i < 128);
+        }
+        if (lower != 'd' && lower != 'w' && lower != 's')
+        {
+            return std::nullopt;
+        }
+        return c == lower ? set : ~set;
+    }
+
+    static char EscapedCharacter(char c)
+    {
+        return c == 'n' ? '\n' : c == 't' ? '\t' : c == 'r' ? '\r' : c;
+    }
+
+    Node ParseAlternation(std::string_view text, std::size_t &position) const
+    {
+        auto node = Node{Node::Kind::Alternation, {}, {}, 0, 0};
+        node.Children.push_back(ParseConcatenation(text, position));
+        while (position < text.size() && text[position] == '|')
+        {
+            position++;
+            node.Children.push_back(ParseConcatenation(text, position));
+        }
+        return node.Children.size() == 1 ? std::move(node.Children.front()) : node;
+    }
+
+    Node ParseConcatenation(std::string_view text, std::size_t &position) const
+    {
+        auto node = Node{Node::Kind::Concatenation, {}, {}, 0, 0};
+        while (position < text.size() && text[position] != '|' && text[position] != ')')
+        {
+            node.Children.push_back(ParseRepetition(text, position));
+        }
+        if (node.Children.empty())
+        {
+            return Node{Node::Kind::Empty, {}, {}, 0, 0};
+        }
+        return node.Children.size() == 1 ? std::move(node.Children.front()) : node;
+    }
+
+    Node ParseRepetition(std::string_view text, std::size_t &position) const
+    {
+        auto node = ParseAtom(text, position);
+        while (position < text.size())
+        {
+            auto min = std::size_t(0), max = Unbounded;
+            auto c = text[position];
+            if (c == '*' || c == '+' || c == '?')
+            {
+                min = c == '+' ? 1 : 0;
+                max = c == '?' ? 1 : Unbounded;
+                position++;
+            }
+            else if (c == '{')
+            {
+                auto end = text.find('}', position);
+                if (end == std::string_view::npos)
+                {
+                    Fail("unterminated '{'");
+                }
+                auto bounds = text.substr(position + 1, end - position - 1);
+                auto comma = bounds.find(',');
+                auto readNumber = [&](std::string_view digits) {
+                    auto isDigit = [](char d) { return std::isdigit(static_cast<unsigned char>(d)) != 0; };
+                    if (digits.empty() || digits.size() > 4 || !std::all_of(digits.begin(), digits.end(), isDigit))
+                    {
+                        Fail("invalid repetition \"{" + std::string(bounds) + "}\"");
+                    }
+                    return static_cast<std::size_t>(std::stoul(std::string(digits)));
+                };
+                min = readNumber(bounds.substr(0, comma));
+                max = comma == std::string_view::npos ? min
+                      : comma + 1 == bounds.size()   ? Unbounded
+                                                     : readNumber(bounds.substr(comma + 1));
+                if (max < min || (max != Unbounded && max > MaxRepetitions) || min > MaxRepetitions)
+                {
+                    Fail("invalid repetition \"{" + std::string(bounds) + "}\"");
+                }
+                position = end + 1;
+            }
+            else
+            {
+                break;
+            }
+            auto repetition = Node{Node::Kind::Repetition, {}, {}, min, max};
+            repetition.Children.push_back(std::move(node));
+            node = std::move(repetition);
+        }
+        return node;
+    }
+
+    Node ParseAtom(std::string_view text, std::size_t &position) const
+    {
+        auto c = text[position++];
+        switch (c)
+        {
+        case '(': {
+            if (text.substr(position, 2) == "?:")
+            {
+                position += 2;
+            }
+            auto node = ParseAlternation(text, position);
+            if (position >= text.size() || text[position] != ')')
+            {
+                Fail("unmatched '('");
+            }
+            position++;
+            return node;
+        }
+        case '[':
+            return Leaf(ParseClass(text, position));
+        case '.':
+            return Leaf(~Single('\n'));
+        case '\\': {
+            if (position >= text.size())
+            {
+                Fail("trailing '\\'");
+            }
+            auto escaped = text[position++];
+            return Leaf(EscapeSet(escaped).value_or(Single(EscapedCharacter(escaped))));
+        }
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+            Fail(std::string("nothing to repeat before '") + c + "'");
+        default:
+            return Leaf(Single(c));
+        }
+    }
+
+    /// @brief Parses a character class after '['.
+    CharacterSet ParseClass(std::string_view text, std::size_t &position) const
+    {
+        auto set = CharacterSet();
+        auto isNegated = position < text.size() && text[position] == '^';
+        position += isNegated ? 1 : 0;
+        auto first = position;
+        while (true)
+        {
+            if (position >= text.size())
+            {
+                Fail("unterminated '['");
+            }
+            if (text[position] == ']' && position != first)
+            {
+                position++;
+                break;
+            }
+
+            auto low = text[position++];
+            if (low == '\\' && position < text.size())
+            {
+                auto escaped = text[position++];
+                auto escapeSet = EscapeSet(escaped);
+                if (escapeSet.has_value())
+                {
+                    set |= escapeSet.value();
+                    continue;
+                }
+                low = EscapedCharacter(escaped);
+            }
+            auto high = low;
+            if (position + 1 < text.size() && text[position] == '-' && text[position + 1] != ']')
+            {
+                high = text[position + 1];
+                position += 2;
+                if (high == '\\' && position < text.size())
+                {
+                    high = EscapedCharacter(text[position++]);
+                }
+                if (static_cast<unsigned char>(high) < static_cast<unsigned char>(low))
+                {
+                    Fail(std::string("invalid range '") + low + "-" + high + "'");
+                }
+            }
+            for (auto i = static_cast<unsigned>(static_cast<unsigned char>(low));
+                 i <= static_cast<unsigned char>(high); i++)
+            {
+                set.set(i);
+            }
+        }
+        return isNegated ? ~set : set;
+    }
+
+    static int AddState(std::vector<NfaState> &nfa)
+    {
+        nfa.push_back(NfaState{CharacterSet(), -1, {}});
+        return static_cast<int>(nfa.size() - 1);
+    }
+
+    /// @brief Builds the states of a node with Thompson's construction.
+    /// @return The start state and the final state, which has no transitions yet.
+    std::pair<int, int> Build(const Node &node, std::vector<NfaState> &nfa) const
+    {
+        if (nfa.size() > MaxStates * 16)
+        {
+            Fail("too many states");
+        }
+
+        auto start = AddState(nfa);
+        auto end = start;
+        switch (node.Type)
+        {
+        case Node::Kind::Empty:
+            break;
+        case Node::Kind::Set:
+            end = AddState(nfa);
+            nfa[start].Set = node.Set;
+            nfa[start].Next = end;
+            break;
+        case Node::Kind::Concatenation:
+            for (const auto &child : node.Children)
+            {
+                auto fragment = Build(child, nfa);
+                nfa[end].Epsilon.push_back(fragment.first);
+                end = fragment.second;
+            }
+            break;
+        case Node::Kind::Alternation:
+            end = AddState(nfa);
+            for (const auto &child : node.Children)
+            {
+                auto fragment = Build(child, nfa);
+                nfa[start].Epsilon.push_back(fragment.first);
+                nfa[fragment.second].Epsilon.push_back(end);
+            }
+            break;
+        case Node::Kind::Repetition:
+            // x{2,4} is built as x x (x (x)?)? and x{2,} as x x x*.
+            for (auto i = std::size_t(0); i < node.Min; i++)
+            {
+                auto fragment = Build(node.Children.front(), nfa);
+                nfa[end].Epsilon.push_back(fragment.first);
+                end = fragment.second;
+            }
+            if (node.Max == Unbounded)
+            {
+                auto fragment = Build(node.Children.front(), nfa);
+                auto last = AddState(nfa);
+                nfa[end].Epsilon.insert(nfa[end].Epsilon.end(), {fragment.first, last});
+                nfa[fragment.second].Epsilon.insert(nfa[fragment.second].Epsilon.end(), {fragment.first, last});
+                end = last;
+            }
+            else if (node.Max > node.Min)
+            {
+                auto last = AddState(nfa);
+                for (auto i = node.Min; i < node.Max; i++)
+                {
+                    auto fragment = Build(node.Children.front(), nfa);
+                    nfa[end].Epsilon.insert(nfa[end].Epsilon.end(), {fragment.first, last});
+                    end = fragment.second;
+                }
+                nfa[end].Epsilon.push_back(last);
+                end = last;
+            }
+            break;
+        }
+        return {start, end};
+    }
+
+    /// @brief Builds the deterministic automaton with the subset construction.
+    void BuildDfa(const std::vector<NfaState> &nfa, int start, int accept)
+    {
+        // Bytes that belong to the same character sets share a column of the transition table.
+        auto signatures = std::vector<std::vector<bool>>(256);
+        for (const auto &state : nfa)
+        {
+            if (state.Next >= 0)
+            {
+                for (auto i = 0; i < 256; i++)
+                {
+                    signatures[i].push_back(state.Set[i]);
+                }
+            }
+        }
+        auto representatives = std::vector<int>();
+        for (auto i = 0; i < 256; i++)
+        {
+            auto found = std::find_if(representatives.begin(), representatives.end(),
+                                      [&](int representative) { return signatures[representative] == signatures[i]; });
+            _Classes[i] = static_cast<uint16_t>(found - representatives.begin());
+            if (found == representatives.end())
+            {
+                representatives.push_back(i);
+            }
+        }
+        _ClassCount = representatives.size();
+
+        auto closure = [&](std::vector<int> states) {
+            auto isIncluded = std::vector<bool>(nfa.size());
+            for (auto i = std::size_t(0); i < states.size(); i++)
+            {
+                if (isIncluded[states[i]])
+                {
+                    continue;
+                }
+                isIncluded[states[i]] = true;
+                for (auto next : nfa[states[i]].Epsilon)
+                {
+                    states.push_back(next);
+                }
+            }
+            auto result = std::vector<int>();
+            for (auto i = std::size_t(0); i < nfa.size(); i++)
+            {
+                if (isIncluded[i])
+                {
+                    result.push_back(static_cast<int>(i));
+                }
+            }
+            return result;
+        };
+
+        auto subsets = std::vector<std::vector<int>>{closure({start})};
+        auto indices = std::map<std::vector<int>, int>{{subsets.front(), 0}};
+        for (auto current = std::size_t(0); current < subsets.size(); current++)
+        {
+            _IsAccepting.push_back(std::binary_search(subsets[current].begin(), subsets[current].end(), accept));
+            for (auto representative : representatives)
+            {
+                auto targets = std::vector<int>();
+                for (auto state : subsets[current])
+                {
+                    if (nfa[state].Next >= 0 && nfa[state].Set[representative])
+                    {
+                        targets.push_back(nfa[state].Next);
+                    }
+                }
+                if (targets.empty())
+                {
+                    _Transitions.push_back(-1);
+                    continue;
+                }
+
+                auto subset = closure(std::move(targets));
+                auto found = indices.find(subset);
+                if (found == indices.end())
+                {
+                    if (subsets.size() >= MaxStates)
+                    {
+                        Fail("too many states");
+                    }
+                    found = indices.emplace(subset, static_cast<int>(subsets.size())).first;
+                    subsets.push_back(std::move(subset));
+                }
+                _Transitions.push_back(found->second);
+            }
+        }
+    }
+};
+
+/// @brief A class that defines command-line arguments and holds the parsing results.
+/// @tparam T The type of the command-line argument.
+template <typename T> class Argument
+{
+  public:
+    /// @brief Creates a command-line argument with a short name.
+    static Argument New(const char &shortName, const std::string &name)
+    {
+        return Argument(std::string(1, shortName), name);
+    }
+
+    /// @brief Creates a command-line argument without a short name.
+    static Argument New(const std::string &name)
+    {
+        return Argument(name);
+    }
+
+    /// @brief Updates the value of a command-line argument.
+    /// @note New creates a command-line argument without a value.
+    ///       By using Update, you can assign a value to it.
+    static Argument Update(const Argument &argument, const std::optional<T> &value)
+    {
+        auto updatedArgument = argument;
+        updatedArgument._Value = value;
+        return updatedArgument;
+    }
+
+    /// @brief Gets the name of the command-line argument.
+    std::string Name() const
+    {
+        return _Name;
+    }
+
+    /// @brief Gets the short name of the command-line argument.
+    std::string ShortName() const
+    {
+        return _ShortName;
+    }
+
+    /// @brief Gets the name of the command-line argument without copying it.
+    std::string_view NameView() const
+    {
+        return _Name;
+    }
+
+    /// @brief Gets the short name of the command-line argument without copying it.
+    std::string_view ShortNameView() const
+    {
+        return _ShortName;
+    }
+
+    /// @brief Gets the description of the command-line argument without copying it.
+    std::string_view DescriptionView() const
+    {
+        return _Description;
+    }
+
+    /// @brief Sets the description of the command-line argument.
+    Argument Description(const std::string &description)
+    {
+        _Description = description;
+        return *this;
+    }
+
+    /// @brief Gets the description of the command-line argument.
+    std::string Description() const
+    {
+        return _Description;
+    }
+
+    /// @brief Sets the default value for the command-line argument.
+    Argument Default(const T &defaultValue)
+    {
+        _DefaultValue = defaultValue;
+        _DefaultFactory.reset();
+        return *this;
+    }
+
+    /// @brief Sets a function that computes the default value when it is first needed.
+    /// @param placeholder Shown in help and in the schema in place of the value, such as "<hostname>".
+    ///                    If empty, the default value is not shown.
+    /// @note The function is only called if no value is given and the default value is read. Its result is shared
+    ///       by the copies of this argument, so it is called at most once.
+    Argument DefaultFrom(std::function<T()> factory, const std::string &placeholder = "")
+    {
+        _DefaultValue.reset();
+        _DefaultFactory = std::make_shared<DefaultFactory>();
+        _DefaultFactory->Function = std::move(factory);
+        _DefaultFactory->Placeholder = placeholder;
+        return *this;
+    }
+
+    /// @brief Gets the default value of the command-line argument.
+    /// @note Returns std::nullopt if no default value is set. A default value set with DefaultFrom() is computed here.
+    std::optional<T> Default() const
+    {
+        if (_DefaultFactory)
+        {
+            return _DefaultFactory->Get();
+        }
+        return _DefaultValue;
+    }
+
+    /// @brief Specifies whether the command-line argument is required.
+    Argument IsRequired(bool isRequired)
+    {
+        _IsRequired = isRequired;
+        return *this;
+    }
+
+    /// @brief Checks whether the command-line argument is required.
+    bool IsRequired() const
+    {
+        return _IsRequired;
+    }
+
+    /// @brief Sets the section under which the command-line argument is listed in the help message.
+    Argument Section(const std::string &section)
+    {
+        _Section = section;
+        return *this;
+    }
+
+    /// @brief Gets the section of the command-line argument.
+    /// @note Returns an empty string if the argument is listed under the common "Options" section.
+    std::string Section() const
+    {
+        return _Section;
+    }
+
+    /// @brief Specifies whether the command-line argument is only listed in the long help message.
+    /// @note Advanced arguments are omitted from the short help message shown by --help, and are shown by
+    ///       --help=all or by --help=<section|keyword>.
+    Argument IsAdvanced(bool isAdvanced)
+    {
+        _IsAdvanced = isAdvanced;
+        return *this;
+    }
+
+    /// @brief Checks whether the command-line argument is only listed in the long help message.
+    bool IsAdvanced() const
+    {
+        return _IsAdvanced;
+    }
+
+    /// @brief Sets the dotted path of the argument in a JSON config, such as "server.port".
+    /// @note If not set, the name of the argument is used as a top-level key.
+    Argument ConfigKey(const std::string &configKey)
+    {
+        _ConfigKey = configKey;
+        return *this;
+    }
+
+    /// @brief Gets the dotted path of the argument in a JSON config.
+    std::string ConfigKey() const
+    {
+        return _ConfigKey.empty() ? _Name : _ConfigKey;
+    }
+
+    /// @brief Requires the value to satisfy a predicate.
+    /// @param message Describes the requirement after the argument name, such as "must be even".
+    Argument Constraint(std::function<bool(const T &)> predicate, const std::string &message)
+    {
+        _Constraints.emplace_back(std::move(predicate), message);
+        return *this;
+    }
+
+    /// @brief Requires the value to be greater than or equal to @c min.
+    Argument Min(const T &min)
+    {
+        if (IsSchemaLimit() && (!_SchemaMinimum.has_value() || *_SchemaMinimum < min))
+        {
+            _SchemaMinimum = min;
+        }
+        return Constraint([min](const T &value) { return !(value < min); }, "must be at least " + ToDisplayString(min));
+    }
+
+    /// @brief Requires the value to be less than or equal to @c max.
+    Argument Max(const T &max)
+    {
+        if (IsSchemaLimit() && (!_SchemaMaximum.has_value() || max < *_SchemaMaximum))
+        {
+            _SchemaMaximum = max;
+        }
+        return Constraint([max](const T &value) { return !(max < value); }, "must be at most " + ToDisplayString(max));
+    }
+
+    /// @brief Requires the value to be one of @c values.
+    Argument OneOf(const std::vector<T> &values)
+    {
+        auto json = std::string();
+        auto text = std::string();
+        for (const auto &value : values)
+        {
+            json += (json.empty() ? "" : ",") + ToJsonValue(value).value_or("null");
+            text += (text.empty() ? "" : ", ") + ToDisplayString(value);
+        }
+        _SchemaConstraints += ",\"enum\":[" + json + "]";
+        return Constraint(
+            [values](const T &value) { return std::find(values.begin(), values.end(), value) != values.end(); },
+            "must be one of " + text);
+    }
+
+    /// @brief Requires the whole value to match a regular expression, such as "[a-z0-9-]{3,63}".
+    /// @note The pattern is compiled to a deterministic automaton once per process, see PatternMatcher.
+    ///       Throws WhispArgException if the pattern is not supported.
+    Argument Pattern(const std::string &pattern)
+    {
+        static_assert(std::is_same_v<T, std::string>, "Pattern() requires Argument<std::string>.");
+        auto matcher = PatternMatcher::Compile(pattern);
+        _SchemaConstraints += ",\"pattern\":\"" + EscapeJson("^(?:" + pattern + ")$") + "\"";
+        return Constraint([matcher](const T &value) { return matcher->Matches(value); },
+                          "must match the pattern \"" + pattern + "\"");
+    }
+
+    /// @brief Sets how WhispArg::Parse() checks and WhispArg::Validate() opens the file of an
+    ///        Argument<type::OutputFile>.
+    Argument OutputOptions(const type::OutputFile::Options &options)
+    {
+        static_assert(std::is_same_v<T, type::OutputFile>, "OutputOptions() requires Argument<type::OutputFile>.");
+        _OutputOptions = options;
+        return *this;
+    }
+
+    /// @brief Gets how the file of an Argument<type::OutputFile> is opened.
+    const type::OutputFile::Options &OutputOptions() const
+    {
+        return _OutputOptions;
+    }
+
+    /// @brief Checks a value against the constraints of the argument.
+    /// @return The messages of the constraints that the value violates, such as
+    ///         "Argument "threads" must be at most 256.".
+    std::vector<std::string> Violations(const T &value) const
+    {
+        auto violations = std::vector<std::string>();
+        for (const auto &constraint : _Constraints)
+        {
+            if (!constraint.first(value))
+            {
+                violations.push_back("Argument \"" + _Name + "\" " + constraint.second + ".");
+            }
+        }
+        return violations;
+    }
+
+    /// @brief Gets the JSON Schema keywords for the constraints, each preceded by a comma.
+    /// @note "minimum" and "maximum" are written once each, with the tightest of the limits of Min(), Max() and a
+    ///       type::Bounded.
+    std::string SchemaConstraints() const
+    {
+        auto minimum = _SchemaMinimum;
+        auto maximum = _SchemaMaximum;
+        if constexpr (type::IsBounded<T>::value)
+        {
+            if (!minimum.has_value() || minimum->Value() < T::Min)
+            {
+                minimum = T(T::Min);
+            }
+            if (!maximum.has_value() || T::Max < maximum->Value())
+            {
+                maximum = T(T::Max);
+            }
+        }
+
+        auto json = std::string();
+        if (minimum.has_value())
+        {
+            json += ",\"minimum\":" + ToJsonValue(*minimum).value_or("null");
+        }
+        if (maximum.has_value())
+        {
+            json += ",\"maximum\":" + ToJsonValue(*maximum).value_or("null");
+        }
+        return json + _SchemaConstraints;
+    }
+
+    /// @brief Gets the value of the command-line argument.
+    /// @note If the value is not set, Default() is returned.
+    std::optional<T> Value() const
+    {
+        return this->_Value.has_value() ? this->_Value : this->Default();
+    }
+
+    /// @brief Gets a reference to the value of the command-line argument.
+    /// @note If the value is not set, the default value is returned. WhispArg::Parse() stores the default value as the
+    ///       value, so reading a parsed argument costs the same as reading a member.
+    ///       Throws WhispArgException if neither is set.
+    const T &Get() const
+    {
+        if (_Value.has_value())
+        {
+            return *_Value;
+        }
+        if (_DefaultValue.has_value())
+        {
+            return *_DefaultValue;
+        }
+        if (_DefaultFactory)
+        {
+            return _DefaultFactory->Get();
+        }
+        throw WhispArgException("Argument \"" + _Name + "\" has no value.");
+    }
+
+    /// @brief Gets a reference to the value, or to @c fallback if neither the value nor the default value is set.
+    const T &ValueOr(const T &fallback) const
+    {
+        return _Value.has_value()          ? *_Value
+               : _DefaultValue.has_value() ? *_DefaultValue
+               : _DefaultFactory           ? _DefaultFactory->Get()
+                                           : fallback;
+    }
+
+    /// @brief Deleted so that the returned reference cannot refer to a temporary.
+    const T &ValueOr(T &&fallback) const = delete;
+
+    /// @brief Converts the command-line argument’s value to a string for help display.
+    const std::string ToHelpString() const
+    {
+        auto upperCaseName = std::string(_Name);
+        std::transform(upperCaseName.begin(), upperCaseName.end(), upperCaseName.begin(),
+                       [](char const &c) { return std::toupper(c); });
+
+        std::stringstream ss;
+        ss << "  ";
+        if (!_ShortName.empty())
+        {
+            ss << "-" << _ShortName << ", ";
+        }
+        ss << "--" << _Name;
+        if constexpr (!std::is_same_v<T, type::Flag>)
+        {
+            ss << " <" << upperCaseName << ">";
+        }
+        ss << "\n";
+        ss << "    " << _Description;
+        if (_DefaultValue.has_value())
+        {
+            ss << " (Default: " << _DefaultValue.value() << ")";
+        }
+        else if (_DefaultFactory && !_DefaultFactory->Placeholder.empty())
+        {
+            ss << " (Default: " << _DefaultFactory->Placeholder << ")";
+        }
+        return ss.str();
+    }
+
+  private:
+    friend class ArgumentInformation;
+
+    /// @brief Computes a default value once.
+    struct DefaultFactory
+    {
+        std::function<T()> Function;
+        std::string Placeholder;
+        std::once_flag Once;
+        std::optional<T> Value;
+
+        const T &Get()
+        {
+            std::call_once(Once, [this]() { Value = Function(); });
+            return *Value;
+        }
+    };
+
+    std::string _Name;
+    std::string _ShortName;
+    std::string _Description;
+    std::optional<T> _DefaultValue;
+    std::shared_ptr<DefaultFactory> _DefaultFactory;
+    bool _IsRequired;
+    std::string _Section;
+    bool _IsAdvanced;
+    std::string _ConfigKey;
+    std::vector<std::pair<std::function<bool(const T &)>, std::string>> _Constraints;
+    std::optional<T> _SchemaMinimum;
+    std::optional<T> _SchemaMaximum;
+    std::string _SchemaConstraints;
+    type::OutputFile::Options _OutputOptions;
+    std::optional<T> _Value;
+
+    /// @brief Whether Min() and Max() are exported as "minimum" and "maximum".
+    static constexpr bool IsSchemaLimit()
+    {
+        return std::is_arithmetic_v<T> || type::IsBounded<T>::value;
+    }
+
+    Argument(const std::string &shortName, const std::string &name)
+        : _Name(name), _ShortName(shortName), _Description(), _DefaultValue(std::nullopt), _DefaultFactory(),
+          _IsRequired(false), _Section(), _IsAdvanced(false), _ConfigKey(), _Constraints(), _SchemaMinimum(),
+          _SchemaMaximum(), _SchemaConstraints(), _OutputOptions()
+    {
+        if constexpr (std::is_same_v<T, type::Flag>)
+        {
+            Default(type::Flag::False);
+        }
+    }
+
+    Argument(const std::string &name) : Argument("", name)
+    {
+    }
+};
+
+/// @brief Parses command-line arguments.
+/// @tparam T The type of the command-line argument.
+/// @param argv A vector of command-line arguments.
+/// @param argument The definition of the command-line argument.
+/// @param converter A function that converts the command-line argument string into type T.
+/// @return The value of the command-line argument (wrapped in std::optional).
+template <typename T>
+std::optional<T> Parse(const std::vector<std::string> &argv, const Argument<T> &argument,
+                       std::function<T(const std::string &)> converter)
+{
+    std::size_t argc = argv.size();
+
+    auto argumentName = argument.Name();
+    auto actualValue = std::string();
+
+    auto shortKey = "-" + argument.ShortName();
+    auto longKey = "--" + argument.Name();
+    auto isArgumentMatched = [&](const std::string &currentArgumentName) {
+        switch (currentArgumentName.size())
+        {
+        case 0:
+        case 1:
+            return false;
+        case 2:
+            if (argument.ShortNameView().empty())
+            {
+                return false;
+            }
+            return shortKey == currentArgumentName;
+        default:
+            return longKey == currentArgumentName;
+        }
+    };
+
+    for (auto i = std::size_t(0); i < argc; i++)
+    {
+        if (argv[i][0] == '-')
+        {
+            const auto &currentArgumentName = argv[i];
+            if (isArgumentMatched(currentArgumentName))
+            {
+                if (std::is_same_v<T, type::Flag>)
+                {
+                    actualValue = type::Flag::True.ToString();
+                }
+                else
+                {
+                    auto nextValueExists = (i + 1) < argc;
+                    if (nextValueExists)
+                    {
+                        actualValue = std::string(nextValueExists ? argv[++i] : "");
+                        continue;
+                    }
+                    else
+                    {
+                        throw WhispArgException("Argument \"" + argumentName + "\" requires a value.");
+                    }
+                }
+            }
+        }
+    }
+
+    if (actualValue.empty())
+    {
+        if (argument.IsRequired())
+        {
+            throw WhispArgException("Argument \"" + argumentName + "\" is required.");
+        }
+
+        return argument.Default();
+    }
+
+    auto value = std::optional<T>();
+    try
+    {
+        value = converter(actualValue);
+    }
+    catch (const std::exception &e)
+    {
+        throw WhispArgException("Failed to parse the argument \"" + argumentName + "\": " + e.what());
+    }
+
+    auto violations = argument.Violations(value.value());
+    if (!violations.empty())
+    {
+        throw WhispArgException(violations.front());
+    }
+    return value;
+}
+
+/// @brief Parses command-line arguments.
+/// @tparam T The type of the command-line argument.
+/// @param argc The number of command-line arguments.
+/// @param argv The command-line arguments.
+/// @param argument The definition of the command-line argument.
+/// @param converter A function that converts the command-line argument string to type T.
+/// @return The value of the command-line argument (wrapped in std::optional).
+template <typename T>
+std::optional<T> Parse(int argc, char *argv[], const Argument<T> &argument,
+                       std::function<T(const std::string &)> converter)
+{
+    return Parse(std::vector<std::string>(argv, argv + argc), argument, converter);
+}
+
+/// @brief Converts text to an integer in [min, max].
+/// @note Throws std::out_of_range instead of narrowing a value that does not fit, and rejects negative values for
+///       unsigned types instead of wrapping them around.
+template <typename T>
+T ConvertInteger(const std::string &value, T min = std::numeric_limits<T>::min(),
+                 T max = std::numeric_limits<T>::max())
+{
+    auto isInRange = false;
+    auto converted = T();
+    if constexpr (std::is_signed_v<T>)
+    {
+        auto parsed = std::stoll(value);
+        isInRange = min <= parsed && parsed <= max;
+        converted = static_cast<T>(parsed);
+    }
+    else
+    {
+        auto begin = value.find_first_not_of(" \t\n\v\f\r");
+        auto parsed = std::stoull(value);
+        isInRange = (begin == std::string::npos || value[begin] != '-') && min <= parsed && parsed <= max;
+        converted = static_cast<T>(parsed);
+    }
+    if (!isInRange)
+    {
+        throw std::out_of_range("Value must be between " + std::to_string(+min) + " and " + std::to_string(+max) +
+                                ".");
+    }
+    return converted;
+}
+
+/// @brief Gets the converter used for types that support automatic conversion.
+/// @tparam T The type of the command-line argument.
+/// @param argument The definition of the command-line argument.
+/// @return A function that converts the command-line argument string into type T.
+/// @note Ensures at compile time that the type is supported.
+///       The returned converter may refer to @c argument, so @c argument must outlive it.
+template <typename T> std::function<T(const std::string &)> AutomaticConverter(const Argument<T> &argument)
+{
+    static_assert(std::is_same_v<T, int8_t> || std::is_same_v<T, int16_t> || std::is_same_v<T, int32_t> ||
+                      std::is_same_v<T, int64_t> || std::is_same_v<T, uint8_t> || std::is_same_v<T, uint16_t> ||
+                      std::is_same_v<T, uint32_t> || std::is_same_v<T, uint64_t> || std::is_same_v<T, float> ||
+                      std::is_same_v<T, double> || std::is_same_v<T, long double> || std::is_same_v<T, std::string> ||
+                      std::is_same_v<T, bool> || std::is_same_v<T, type::Flag> ||
+                      std::is_same_v<T, type::IpAddress> || std::is_same_v<T, type::Endpoint> ||
+                      std::is_same_v<T, type::Cidr> || std::is_same_v<T, type::Timestamp> ||
+                      std::is_same_v<T, type::Glob> || std::is_same_v<T, type::OutputFile> ||
+                      std::is_same_v<T, type::Url> || type::IsList<T>::value || type::IsBounded<T>::value,
+                  "Type not supported automatically. Please provide a converter function.");
+
+    if constexpr (std::is_same_v<T, int8_t> || std::is_same_v<T, int16_t> || std::is_same_v<T, int32_t> ||
+                  std::is_same_v<T, int64_t> || std::is_same_v<T, uint8_t> || std::is_same_v<T, uint16_t> ||
+                  std::is_same_v<T, uint32_t> || std::is_same_v<T, uint64_t>)
+    {
+        return [](const std::string &value) { return ConvertInteger<T>(value); };
+    }
+    else if constexpr (type::IsBounded<T>::value)
+    {
+        using Integer = typename T::value_type;
+        return [](const std::string &value) { return T(ConvertInteger<Integer>(value, T::Min, T::Max)); };
+    }
+    else if constexpr (std::is_same_v<T, float>)
+    {
+        return [](const std::string &value) { return std::stof(value); };
+    }
+    else if constexpr (std::is_same_v<T, double>)
+    {
+        return [](const std::string &value) { return std::stod(value); };
+    }
+    else if constexpr (std::is_same_v<T, long double>)
+    {
+        return [](const std::string &value) { return std::stold(value); };
+    }
+    else if constexpr (std::is_same_v<T, std::string>)
+    {
+        return [](const std::string &value) { return value; };
+    }
+    else if constexpr (std::is_same_v<T, bool>)
+    {
+        return [](const std::string &value) {
+            if (value == "true")
+            {
+                return true;
+            }
+            else if (value == "false")
+            {
+                return false;
+            }
+            else
+            {
+                try
+                {
+                    auto integerValue = std::stoll(value);
+                    return static_cast<bool>(integerValue);
+                }
+                catch (const std::exception &e)
+                {
+                    throw WhispArgException("Value must be either \"true\"(1) or \"false\"(0).");
+                }
+            }
+        };
+    }
+    else if constexpr (std::is_same_v<T, type::Flag>)
+    {
+        return [&argument](const std::string &) { return !argument.Value().value(); };
+    }
+    else if constexpr (std::is_same_v<T, type::IpAddress> || std::is_same_v<T, type::Endpoint> ||
+                       std::is_same_v<T, type::Cidr> || std::is_same_v<T, type::Timestamp> ||
+                       std::is_same_v<T, type::Glob> || std::is_same_v<T, type::OutputFile> ||
+                       std::is_same_v<T, type::Url>)
+    {
+        return [](const std::string &value) { return T::Parse(value); };
+    }
+    else if constexpr (type::IsList<T>::value)
+    {
+        using Element = typename T::value_type;
+        static_assert(!std::is_same_v<Element, type::Flag>, "A list of flags is not supported.");
+        return [element = AutomaticConverter(Argument<Element>::New("element"))](const std::string &value) {
+            auto list = T();
+            auto begin = std::size_t(0);
+            while (true)
+            {
+                auto end = value.find(',', begin);
+                auto item = value.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+                if (item.empty())
+                {
+                    throw WhispArgException("List \"" + value + "\" has an empty element.");
+                }
+                list.push_back(element(item));
+                if (end == std::string::npos)
+                {
+                    return list;
+                }
+                begin = end + 1;
+            }
+        };
+    }
+    else
+    {
+        WhispArgException("Type not supported.");
+    }
+}
+
+/// @brief Parses command-line arguments for types that support automatic conversion.
+/// @tparam T The type of the command-line argument.
+/// @param argv A vector of command-line arguments.
+/// @param argument The definition of the command-line argument.
+/// @return The value of the command-line argument (wrapped in std::optional).
+/// @note Ensures at compile time that the type is supported.
+template <typename T> std::optional<T> Parse(const std::vector<std::string> &argv, const Argument<T> &argument)
+{
+    return Parse(argv, argument, AutomaticConverter(argument));
+}
+
+/// @brief Parses command-line arguments for types that support automatic conversion.
+/// @tparam T The type of the command-line argument.
+/// @param argc The number of command-line arguments.
+/// @param argv The command-line arguments.
+/// @param argument The definition of the command-line argument.
+/// @return The value of the command-line argument (wrapped in std::optional).
+/// @note Ensures at compile time that the type is supported.
+template <typename T> std::optional<T> Parse(int argc, char *argv[], const Argument<T> &argument)
+{
+    return Parse(std::vector<std::string>(argv, argv + argc), argument);
+}
+
+/// @brief A preset Argument for the --help option.
+inline Argument<type::Flag> Help =
+    Argument<type::Flag>::New('h', "help").Description("Show help message.").Default(type::Flag::False);
+
+template <typename T> constexpr std::string_view TypeName();
+
+/// @brief Joins strings at compile time into one with static storage.
+/// @tparam Parts The strings, which must have static storage themselves.
+template <const std::string_view &...Parts> struct JoinedName
+{
+    static constexpr auto Storage = []() {
+        auto storage = std::array<char, (Parts.size() + ... + 0)>{};
+        auto position = std::size_t(0);
+        for (auto part : {Parts...})
+        {
+            for (auto c : part)
+            {
+                storage[position++] = c;
+            }
+        }
+        return storage;
+    }();
+    static constexpr auto Value = std::string_view(Storage.data(), Storage.size());
+};
+
+/// @brief Formats an integer in decimal at compile time.
+template <auto N> struct DecimalName
+{
+    // 20 digits of UINT64_MAX, or 19 digits and a sign of INT64_MIN.
+    static constexpr auto Storage = []() {
+        auto storage = std::array<char, 20>{};
+        auto position = storage.size();
+        auto isNegative = false;
+        auto magnitude = static_cast<unsigned long long>(N);
+        if constexpr (std::is_signed_v<decltype(N)>)
+        {
+            if (N < 0)
+            {
+                isNegative = true;
+                magnitude = 0ULL - magnitude;
+            }
+        }
+        do
+        {
+            storage[--position] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+        if (isNegative)
+        {
+            storage[--position] = '-';
+        }
+        return std::pair(storage, position);
+    }();
+    static constexpr auto Value =
+        std::string_view(Storage.first.data() + Storage.second, Storage.first.size() - Storage.second);
+};
+
+/// @brief Names the class templates of the library at compile time. See TypeName().
+template <typename T> struct TemplateTypeName
+{
+};
+
+template <typename T> struct TemplateTypeName<type::List<T>>
+{
+    static constexpr std::string_view Prefix = "idofront::whisparg::type::List<";
+    static constexpr std::string_view Element = TypeName<T>();
+    static constexpr std::string_view Suffix = ">";
+    static constexpr auto Value = JoinedName<Prefix, Element, Suffix>::Value;
+};
+
+template <typename T, T Lo, T Hi> struct TemplateTypeName<type::Bounded<T, Lo, Hi>>
+{
+    static constexpr std::string_view Prefix = "idofront::whisparg::type::Bounded<";
+    static constexpr std::string_view Element = TypeName<T>();
+    static constexpr std::string_view Separator = ", ";
+    static constexpr std::string_view Suffix = ">";
+    static constexpr auto Value = JoinedName<Prefix, Element, Separator, DecimalName<Lo>::Value, Separator,
+                                             DecimalName<Hi>::Value, Suffix>::Value;
+};
+
+/// @brief Gets the name of a C++ type at compile time.
+/// @tparam T The type.
+/// @note Types that support automatic conversion get the same name on every compiler: fundamental types get their
+///       conventional names, such as "uint16_t" or "std::string", and the types of this library are qualified
+///       in full, such as "idofront::whisparg::type::Bounded<int32_t, 1, 256>". Other types are named by the
+///       compiler.
+template <typename T> constexpr std::string_view TypeName()
+{
+    if constexpr (std::is_same_v<T, int8_t>)
+        return "int8_t";
+    else if constexpr (std::is_same_v<T, int16_t>)
+        return "int16_t";
+    else if constexpr (std::is_same_v<T, int32_t>)
+        return "int32_t";
+    else if constexpr (std::is_same_v<T, int64_t>)
+        return "int64_t";
+    else if constexpr (std::is_same_v<T, uint8_t>)
+        return "uint8_t";
+    else if constexpr (std::is_same_v<T, uint16_t>)
+        return "uint16_t";
+    else if constexpr (std::is_same_v<T, uint32_t>)
+        return "uint32_t";
+    else if constexpr (std::is_same_v<T, uint64_t>)
+        return "uint64_t";
+    else if constexpr (std::is_same_v<T, bool>)
+        return "bool";
+    else if constexpr (std::is_same_v<T, float>)
+        return "float";
+    else if constexpr (std::is_same_v<T, double>)
+        return "double";
+    else if constexpr (std::is_same_v<T, long double>)
+        return "long double";
+    else if constexpr (std::is_same_v<T, std::string>)
+        return "std::string";
+    else if constexpr (std::is_same_v<T, type::Flag>)
+        return "idofront::whisparg::type::Flag";
+    else if constexpr (std::is_same_v<T, type::IpAddress>)
+        return "idofront::whisparg::type::IpAddress";
+    else if constexpr (std::is_same_v<T, type::Endpoint>)
+        return "idofront::whisparg::type::Endpoint";
+    else if constexpr (std::is_same_v<T, type::Cidr>)
+        return "idofront::whisparg::type::Cidr";
+    else if constexpr (std::is_same_v<T, type::Timestamp>)
+        return "idofront::whisparg::type::Timestamp";
+    else if constexpr (std::is_same_v<T, type::Glob>)
+        return "idofront::whisparg::type::Glob";
+    else if constexpr (std::is_same_v<T, type::OutputFile>)
+        return "idofront::whisparg::type::OutputFile";
+    else if constexpr (std::is_same_v<T, type::Url>)
+        return "idofront::whisparg::type::Url";
+    else if constexpr (type::IsList<T>::value || type::IsBounded<T>::value)
+        return TemplateTypeName<T>::Value;
+    else
+    {
+#if defined(__clang__) || defined(__GNUC__)
+        // "... TypeName() [with T = <type>; ...]" (GCC) or "... TypeName() [T = <type>]" (Clang)
+        constexpr auto function = std::string_view(__PRETTY_FUNCTION__);
+        constexpr auto begin = function.find("T = ") + 4;
+        constexpr auto end = function.find_first_of(";]", begin);
+        return function.substr(begin, end - begin);
+#elif defined(_MSC_VER)
+        // "... TypeName<<type>>(void)"
+        constexpr auto function = std::string_view(__FUNCSIG__);
+        constexpr auto begin = function.find("TypeName<") + 9;
+        constexpr auto end = function.rfind(">(void)");
+        return function.substr(begin, end - begin);
+#else
+        return "unknown";
+#endif
+    }
+}
+
+/// @brief Gets the JSON Schema type of the values of a C++ type at compile time.
+template <typename T> constexpr std::string_view JsonTypeName()
+{
+    if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, type::Flag>)
+        return "boolean";
+    else if constexpr (std::is_integral_v<T> || type::IsBounded<T>::value)
+        return "integer";
+    else if constexpr (std::is_floating_point_v<T>)
+        return "number";
+    else
+        return "string";
+}
+
+/// @brief A class that holds information about a command-line argument.
+class ArgumentInformation
+{
+  public:
+    /// @brief Creates an ArgumentInformation object from an Argument object.
+    template <typename T> static ArgumentInformation New(const Argument<T> &argument)
+    {
+        auto isFlag = std::is_same_v<T, type::Flag>;
+        auto information = ArgumentInformation(argument._Name, argument._ShortName, argument._Description, isFlag,
+                                               argument._IsRequired, argument._Section, argument._IsAdvanced);
+        information._TypeName = ::idofront::whisparg::TypeName<T>();
+        information._JsonTypeName = JsonTypeName<T>();
+        if (argument._DefaultValue.has_value())
+        {
+            information._DefaultJson = ToJsonValue(*argument._DefaultValue);
+        }
+        else if (argument._DefaultFactory && !argument._DefaultFactory->Placeholder.empty())
+        {
+            // The default value is not computed just to describe it.
+            information._DefaultPlaceholder = argument._DefaultFactory->Placeholder;
+        }
+        information._SchemaConstraints = argument.SchemaConstraints();
+        return information;
+    }
+
+    /// @brief Constructs an ArgumentInformation object.
+    ArgumentInformation(std::string name, std::string shortName, std::string description, bool isFlag,
+                        bool isRequired, std::string section = "", bool isAdvanced = false)
+        : _Name(std::move(name)), _ShortName(std::move(shortName)), _Description(std::move(description)),
+          _IsFlag(isFlag), _IsRequired(isRequired), _Section(std::move(section)), _IsAdvanced(isAdvanced)
+    {
+    }
+
+    /// @brief Name.
+    const std::string &Name() const
+    {
+        return _Name;
+    }
+
+    /// @brief Short name.
+    const std::string &ShortName() const
+    {
+        return _ShortName;
+    }
+
+    /// @brief Description.
+    const std::string &Description() const
+    {
+        return _Description;
+    }
+
+    /// @brief Whether it is a flag.
+    bool IsFlag() const
+    {
+        return _IsFlag;
+    }
+
+    /// @brief Whether it is required.
+    bool IsRequired() const
+    {
+        return _IsRequired;
+    }
+
+    /// @brief Section in the help message.
+    const std::string &Section() const
+    {
+        return _Section;
+    }
+
+    /// @brief Whether it is only listed in the long help message.
+    bool IsAdvanced() const
+    {
+        return _IsAdvanced;
+    }
+
+    /// @brief Name of the C++ value type. See TypeName().
+    std::string_view TypeName() const
+    {
+        return _TypeName;
+    }
+
+    /// @brief Writes the argument as a JSON object.
+    std::string ToJson() const
+    {
+        auto json = std::string("{");
+        json += "\"name\":\"" + EscapeJson(_Name) + "\"";
+        if (!_ShortName.empty())
+        {
+            json += ",\"shortName\":\"" + EscapeJson(_ShortName) + "\"";
+        }
+        json += ",\"type\":\"" + std::string(_JsonTypeName) + "\"";
+        json += ",\"cppType\":\"" + EscapeJson(_TypeName) + "\"";
+        json += ",\"description\":\"" + EscapeJson(_Description) + "\"";
+        json += std::string(",\"required\":") + (_IsRequired ? "true" : "false");
+        json += std::string(",\"flag\":") + (_IsFlag ? "true" : "false");
+        if (_DefaultJson.has_value())
+        {
+            json += ",\"default\":" + _DefaultJson.value();
+        }
+        if (!_DefaultPlaceholder.empty())
+        {
+            json += ",\"defaultPlaceholder\":\"" + EscapeJson(_DefaultPlaceholder) + "\"";
+        }
+        json += _SchemaConstraints;
+        if (!_Section.empty())
+        {
+            json += ",\"section\":\"" + EscapeJson(_Section) + "\"";
+        }
+        json += std::string(",\"advanced\":") + (_IsAdvanced ? "true" : "false");
+        json += "}";
+        return json;
+    }
+
+  private:
+    std::string _Name;
+    std::string _ShortName;
+    std::string _Description;
+    bool _IsFlag;
+    bool _IsRequired;
+    std::string _Section;
+    bool _IsAdvanced;
+    std::string_view _TypeName = "unknown";
+    std::string_view _JsonTypeName = "string";
+    std::optional<std::string> _DefaultJson;
+    std::string _DefaultPlaceholder;
+    std::string _SchemaConstraints;
+};
+
+/// @brief A null-terminated argument vector for execve() or posix_spawn(), built by WhispArg::ToArgv().
+/// @note The pointers and the strings they point to share one allocation, so moving the object keeps them valid.
+class ArgumentVector
+{
+  public:
+    /// @brief Builds a vector from a function that calls its argument once per token.
+    /// @param visit Called twice with a callback that takes the pieces of one token: first to measure the tokens,
+    ///              then to copy them. It must produce the same tokens both times.
+    template <typename Visit> static ArgumentVector Build(Visit visit)
+    {
+        auto count = std::size_t(0);
+        auto bytes = std::size_t(0);
+        visit([&](std::string_view first, std::string_view second) {
+            count++;
+            bytes += first.size() + second.size() + 1;
+        });
+
+        auto vector = ArgumentVector();
+        auto slots = count + 1 + (bytes + sizeof(char *) - 1) / sizeof(char *);
+        vector._Block = std::make_unique<char *[]>(slots);
+        vector._Argc = count;
+
+        auto pointers = vector._Block.get();
+        auto text = reinterpret_cast<char *>(pointers + count + 1);
+        auto index = std::size_t(0);
+        visit([&](std::string_view first, std::string_view second) {
+            pointers[index++] = text;
+            std::memcpy(text, first.data(), first.size());
+            std::memcpy(text + first.size(), second.data(), second.size());
+            text += first.size() + second.size();
+            *text++ = '\0';
+        });
+        pointers[count] = nullptr;
+        return vector;
+    }
+
+    /// @brief Gets the number of arguments.
+    int Argc() const
+    {
+        return static_cast<int>(_Argc);
+    }
+
+    /// @brief Gets the arguments, followed by a null pointer.
+    char *const *Argv() const
+    {
+        return _Block.get();
+    }
+
+    /// @brief Gets an argument.
+    std::string_view operator[](std::size_t index) const
+    {
+        return _Block[index];
+    }
+
+    /// @brief Copies the arguments into strings.
+    std::vector<std::string> ToVector() const
+    {
+        return std::vector<std::string>(_Block.get(), _Block.get() + _Argc);
+    }
+
+  private:
+    std::unique_ptr<char *[]> _Block;
+    std::size_t _Argc = 0;
+};
+
+/// @brief A read-only view of the contents of a file.
+/// @note The file is memory-mapped on POSIX platforms, and read into memory elsewhere.
+class MappedFile
+{
+  public:
+    /// @brief Opens and maps the file.
+    /// @param path The path of the file.
+    explicit MappedFile(const std::string &path)
+    {
+#if defined(IDOFRONT__WHISPARG__POSIX)
+        auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throw WhispArgException("Failed to open \"" + path + "\": " + std::strerror(errno));
+        }
+        struct stat status;
+        if (::fstat(fd, &status) != 0)
+        {
+            auto error = errno;
+            ::close(fd);
+            throw WhispArgException("Failed to stat \"" + path + "\": " + std::strerror(error));
+        }
+        _Size = static_cast<std::size_t>(status.st_size);
+        if (_Size > 0)
+        {
+            auto address = ::mmap(nullptr, _Size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address == MAP_FAILED)
+            {
+                auto error = errno;
+                ::close(fd);
+                throw WhispArgException("Failed to map \"" + path + "\": " + std::strerror(error));
+            }
+            ::madvise(address, _Size, MADV_SEQUENTIAL);
+            _Data = static_cast<const char *>(address);
+        }
+        ::close(fd);
+#else
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream)
+        {
+            throw WhispArgException("Failed to open \"" + path + "\".");
+        }
+        _Buffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        _Data = _Buffer.data();
+        _Size = _Buffer.size();
+#endif
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile()
+    {
+#if defined(IDOFRONT__WHISPARG__POSIX)
+        if (_Data != nullptr)
+        {
+            ::munmap(const_cast<char *>(_Data), _Size);
+        }
+#endif
+    }
+
+    /// @brief Gets the contents of the file.
+    std::string_view View() const
+    {
+        return std::string_view(_Data, _Size);
+    }
+
+  private:
+    const char *_Data = nullptr;
+    std::size_t _Size = 0;
+#if !defined(IDOFRONT__WHISPARG__POSIX)
+    std::string _Buffer;
+#endif
+};
+
+/// @brief A JSON document used as a source of argument values.
+/// @note The document is not parsed up front. Each lookup scans only the path to the requested key and skips the
+///       members it does not need by matching brackets, so reading a few keys from a large document is cheap.
+class JsonSource
+{
+  public:
+    /// @brief Maps a JSON file.
+    static std::shared_ptr<const JsonSource> FromFile(const std::string &path)
+    {
+        auto source = std::shared_ptr<JsonSource>(new JsonSource());
+        source->_File = std::make_unique<MappedFile>(path);
+        source->_Text = source->_File->View();
+        return source;
+    }
+
+    /// @brief Uses JSON text held in memory.
+    static std::shared_ptr<const JsonSource> FromString(const std::string &text)
+    {
+        auto source = std::shared_ptr<JsonSource>(new JsonSource());
+        source->_Buffer = text;
+        source->_Text = source->_Buffer;
+        return source;
+    }
+
+    /// @brief Finds a value by its dotted path, such as "server.tls.cert".
+    /// @return A string value without quotes, the text of a number, true or false, the JSON text of an object or
+    ///         array, or std::nullopt if the path does not exist or the value is null.
+    /// @note Throws WhispArgException if the document is malformed along the path.
+    std::optional<std::string> Find(std::string_view path) const
+    {
+        auto position = SkipWhitespace(0);
+        while (true)
+        {
+            auto dot = path.find('.');
+            auto key = path.substr(0, dot);
+            if (!FindMember(position, key))
+            {
+                return std::nullopt;
+            }
+            if (dot == std::string_view::npos)
+            {
+                return ReadValue(position);
+            }
+            path.remove_prefix(dot + 1);
+        }
+    }
+
+  private:
+    std::unique_ptr<MappedFile> _File;
+    std::string _Buffer;
+    std::string_view _Text;
+
+    JsonSource() = default;
+
+    [[noreturn]] void Fail(std::size_t position, const std::string &message) const
+    {
+        throw WhispArgException("Malformed JSON at offset " + std::to_string(position) + ": " + message);
+    }
+
+    std::size_t SkipWhitespace(std::size_t position) const
+    {
+        while (position < _Text.size() &&
+               (_Text[position] == ' ' || _Text[position] == '\t' || _Text[position] == '\n' ||
+                _Text[position] == '\r'))
+        {
+            position++;
+        }
+        return position;
+    }
+
+    void Expect(std::size_t position, char c) const
+    {
+        if (position >= _Text.size() || _Text[position] != c)
+        {
+            Fail(position, std::string("expected '") + c + "'");
+        }
+    }
+
+    /// @brief Finds the end of the string that starts at @c position.
+    std::size_t SkipString(std::size_t position) const
+    {
+        Expect(position, '"');
+        for (position++; position < _Text.size(); position++)
+        {
+            auto found = _Text.find_first_of("\"\\", position);
+            if (found == std::string_view::npos)
+            {
+                break;
+            }
+            if (_Text[found] == '"')
+            {
+                return found + 1;
+            }
+            position = found + 1;
+        }
+        Fail(position, "unterminated string");
+    }
+
+    /// @brief Finds the end of the value that starts at @c position, without interpreting it.
+    std::size_t SkipValue(std::size_t position) const
+    {
+        if (position >= _Text.size())
+        {
+            Fail(position, "expected a value");
+        }
+        auto c = _Text[position];
+        if (c == '"')
+        {
+            return SkipString(position);
+        }
+        if (c != '{' && c != '[')
+        {
+            auto end = position;
+            while (end < _Text.size() && _Text[end] != ',' && _Text[end] != '}' && _Text[end] != ']' &&
+                   _Text[end] != ' ' && _Text[end] != '\t' && _Text[end] != '\n' && _Text[end] != '\r')
+            {
+                end++;
+            }
+            if (end == position)
+            {
+                Fail(position, "expected a value");
+            }
+            return end;
+        }
+
+        auto depth = std::size_t(0);
+        while (position < _Text.size())
+        {
+            auto found = _Text.find_first_of("\"{}[]", position);
+            if (found == std::string_view::npos)
+            {
+                break;
+            }
+            switch (_Text[found])
+            {
+            case '"':
+                position = SkipString(found);
+                continue;
+            case '{':
+            case '[':
+                depth++;
+                break;
+            default:
+                depth--;
+                if (depth == 0)
+                {
+                    return found + 1;
+                }
+            }
+            position = found + 1;
+        }
+        Fail(position, "unterminated object or array");
+    }
+
+    /// @brief Moves @c position from the start of an object to the value of the member named @c key.
+    /// @return false if the value at @c position is not an object or has no such member.
+    bool FindMember(std::size_t &position, std::string_view key) const
+    {
+        if (position >= _Text.size() || _Text[position] != '{')
+        {
+            return false;
+        }
+        position = SkipWhitespace(position + 1);
+        if (position < _Text.size() && _Text[position] == '}')
+        {
+            return false;
+        }
+
+        while (true)
+        {
+            auto keyEnd = SkipString(position);
+            auto rawKey = _Text.substr(position + 1, keyEnd - position - 2);
+            auto isMatched = rawKey.find('\\') == std::string_view::npos ? rawKey == key
+                                                                          : Unescape(position, keyEnd) == key;
+
+            position = SkipWhitespace(keyEnd);
+            Expect(position, ':');
+            position = SkipWhitespace(position + 1);
+            if (isMatched)
+            {
+                return true;
+            }
+
+            position = SkipWhitespace(SkipValue(position));
+            if (position < _Text.size() && _Text[position] == '}')
+            {
+                return false;
+            }
+            Expect(position, ',');
+            position = SkipWhitespace(position + 1);
+        }
+    }
+
+    /// @brief Reads the value at @c position.
+    std::optional<std::string> ReadValue(std::size_t position) const
+    {
+        auto end = SkipValue(position);
+        if (_Text[position] == '"')
+        {
+            return Unescape(position, end);
+        }
+        auto text = _Text.substr(position, end - position);
+        if (text == "null")
+        {
+            return std::nullopt;
+        }
+        return std::string(text);
+    }
+
+    /// @brief Decodes the string literal in [begin, end), including its quotes.
+    std::string Unescape(std::size_t begin, std::size_t end) const
+    {
+        auto text = std::string();
+        auto readHex = [&](std::size_t position) {
+            if (position + 4 > end - 1)
+            {
+                Fail(position, "truncated \\u escape");
+            }
+            auto value = 0u;
+            for (auto i = position; i < position + 4; i++)
+            {
+                auto c = _Text[i];
+                value <<= 4;
+                if (c >= '0' && c <= '9')
+                    value |= static_cast<unsigned>(c - '0');
+                else if (c >= 'a' && c <= 'f')
+                    value |= static_cast<unsigned>(c - 'a' + 10);
+                else if (c >= 'A' && c <= 'F')
+                    value |= static_cast<unsigned>(c - 'A' + 10);
+                else
+                    Fail(i, "invalid \\u escape");
+            }
+            return value;
+        };
+
+        for (auto position = begin + 1; position < end - 1; position++)
+        {
+            auto c = _Text[position];
+            if (c != '\\')
+            {
+                text += c;
+                continue;
+            }
+            switch (_Text[++position])
+            {
+            case 'b':
+                text += '\b';
+                break;
+            case 'f':
+                text += '\f';
+                break;
+            case 'n':
+                text += '\n';
+                break;
+            case 'r':
+                text += '\r';
+                break;
+            case 't':
+                text += '\t';
+                break;
+            case 'u': {
+                auto codePoint = readHex(position + 1);
+                position += 4;
+                if (codePoint >= 0xd800 && codePoint < 0xdc00 && position + 2 < end - 1 &&
+                    _Text[position + 1] == '\\' && _Text[position + 2] == 'u')
+                {
+                    auto low = readHex(position + 3);
+                    if (low >= 0xdc00 && low < 0xe000)
+                    {
+                        codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (low - 0xdc00);
+                        position += 6;
+                    }
+                }
+                if (codePoint < 0x80)
+                {
+                    text += static_cast<char>(codePoint);
+                }
+                else if (codePoint < 0x800)
+                {
+                    text += static_cast<char>(0xc0 | (codePoint >> 6));
+                    text += static_cast<char>(0x80 | (codePoint & 0x3f));
+                }
+                else if (codePoint < 0x10000)
+                {
+                    text += static_cast<char>(0xe0 | (codePoint >> 12));
+                    text += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+                    text += static_cast<char>(0x80 | (codePoint & 0x3f));
+                }
+                else
+                {
+                    text += static_cast<char>(0xf0 | (codePoint >> 18));
+                    text += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f));
+                    text += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+                    text += static_cast<char>(0x80 | (codePoint & 0x3f));
+                }
+                break;
+            }
+            default:
+                text += _Text[position];
+            }
+        }
+        return text;
+    }
+};
+
+/// @brief An option value set by a Profile.
+struct ProfileEntry
+{
+    /// @brief The name of the argument, without the leading "--".
+    std::string_view Name;
+    /// @brief The value, written as it would be on the command line.
+    std::string_view Value;
+};
+
+/// @brief A named bundle of option values, selected with --profile <name>.
+/// @note Profiles can be defined as constexpr tables:
+///       @code
+///       constexpr ProfileEntry LowLatency[] = {{"threads", "4"}, {"batch-size", "1"}};
+///       auto parser = WhispArg(argc, argv).AddProfile(Profile("low-latency", LowLatency));
+///       @endcode
+///       A value from the selected profile overrides the default value, and is overridden by the command line.
+class Profile
+{
+  public:
+    /// @brief Constructs a Profile object from a table of entries.
+    /// @note The table is referenced, not copied, so it must outlive the Profile object.
+    template <std::size_t N>
+    constexpr Profile(std::string_view name, const ProfileEntry (&entries)[N])
+        : _Name(name), _Entries(entries), _Size(N)
+    {
+    }
+
+    /// @brief The name of the profile.
+    constexpr std::string_view Name() const
+    {
+        return _Name;
+    }
+
+    /// @brief The first entry of the profile.
+    constexpr const ProfileEntry *begin() const
+    {
+        return _Entries;
+    }
+
+    /// @brief The end of the entries of the profile.
+    constexpr const ProfileEntry *end() const
+    {
+        return _Entries + _Size;
+    }
+
+  private:
+    std::string_view _Name;
+    const ProfileEntry *_Entries;
+    std::size_t _Size;
+};
+
+/// @brief A preset Argument for the --profile option, which selects a Profile.
+inline Argument<std::string> ProfileArgument =
+    Argument<std::string>::New("profile").Description("Apply a preset profile of option values.");
+
+#if defined(IDOFRONT__WHISPARG__POSIX)
+/// @brief A class that reads delimited tokens from a file descriptor as they arrive.
+/// @note This is intended for pipelines such as `find ... -print0 | tool --args-from-stdin`.
+///       The input is read through a fixed-size buffer, and each call to Next returns as soon as one token is
+///       complete, so the application can process early tokens while later ones are still being written.
+///       Only a token that spans a buffer boundary is copied into an intermediate string.
+class TokenStream
+{
+  public:
+    /// @brief Constructs a TokenStream object.
+    /// @param fd The file descriptor to read from. It is not closed by TokenStream.
+    /// @param delimiter The character that terminates each token, typically '\n' or '\0'.
+    /// @param bufferSize The size of the read buffer.
+    explicit TokenStream(int fd, char delimiter = '\n', std::size_t bufferSize = 64 * 1024)
+        : _Fd(fd), _Delimiter(delimiter), _Buffer(new char[std::max(std::size_t(1), bufferSize)]),
+          _BufferSize(std::max(std::size_t(1), bufferSize))
+    {
+    }
+
+    /// @brief Reads the next token.
+    /// @param token Receives the token.
+    /// @return false if the end of the input has been reached.
+    /// @note A final token without a trailing delimiter is returned as well. Empty tokens are skipped.
+    bool Next(std::string &token)
+    {
+        while (true)
+        {
+            auto begin = _Buffer.get() + _Begin;
+            auto delimiter = static_cast<const char *>(std::memchr(begin, _Delimiter, _End - _Begin));
+            if (delimiter != nullptr)
+            {
+                auto length = static_cast<std::size_t>(delimiter - begin);
+                _Begin += length + 1;
+                if (_Partial.empty())
+                {
+                    token.assign(begin, length);
+                }
+                else
+                {
+                    _Partial.append(begin, length);
+                    token.swap(_Partial);
+                    _Partial.clear();
+                }
+                if (token.empty())
+                {
+                    continue;
+                }
+                return true;
+            }
+
+            _Partial.append(begin, _End - _Begin);
+            _Begin = _End = 0;
+            if (_IsEnd || !Fill())
+            {
+                _IsEnd = true;
+                if (_Partial.empty())
+                {
+                    return false;
+                }
+                token.swap(_Partial);
+                _Partial.clear();
+                return true;
+            }
+        }
+    }
+
+    /// @brief Reads the next token.
+    /// @return The token, or std::nullopt if the end of the input has been reached.
+    std::optional<std::string> Next()
+    {
+        auto token = std::string();
+        return Next(token) ? std::optional<std::string>(std::move(token)) : std::nullopt;
+    }
+
+  private:
+    int _Fd;
+    char _Delimiter;
+    std::unique_ptr<char[]> _Buffer;
+    std::size_t _BufferSize;
+    std::size_t _Begin = 0;
+    std::size_t _End = 0;
+    bool _IsEnd = false;
+    /// @brief The beginning of a token that spans a buffer boundary.
+    std::string _Partial;
+
+    /// @brief Reads more input into the buffer.
+    /// @return false at the end of the input.
+    bool Fill()
+    {
+        while (true)
+        {
+            auto size = ::read(_Fd, _Buffer.get(), _BufferSize);
+            if (size < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (size < 0)
+            {
+                throw WhispArgException(std::string("Failed to read arguments: ") + std::strerror(errno));
+            }
+            _End = static_cast<std::size_t>(size);
+            return size > 0;
+        }
+    }
+};
+#endif
+
+/// @brief A preset Argument for the --args-from-stdin option.
+/// @note When it is set, call WhispArg::ArgumentsFrom(STDIN_FILENO, '\0') to read NUL-delimited arguments, or pass '\n'
+///       for one argument per line.
+inline Argument<type::Flag> ArgumentsFromStdinArgument =
+    Argument<type::Flag>::New("args-from-stdin").Description("Read more arguments from the standard input.");
+
+/// @brief A class that parses command-line arguments.
+/// @note Although you can parse arguments using the Parse() function directly,
+///       using the WhispArg class allows you to generate help messages from multiple command-line arguments.
+class WhispArg
+{
+  public:
+    /// @brief Constructs a WhispArg object to parse command-line arguments.
+    WhispArg(int argc, char *argv[])
+        : _ArgumentValues(std::vector<std::string>(argv, argv + argc)), _ArgumentInformations(), _Description()
+    {
+    }
+
+    /// @brief Constructs a WhispArg object for the command line of the current process.
+    /// @note Works where argc and argv are not available, such as in static initializers or deep in a library.
+    ///       See ProcessArguments().
+    static WhispArg FromProcess()
+    {
+        const auto &arguments = ProcessArguments();
+        return WhispArg(std::vector<std::string>(arguments.begin(), arguments.end()));
+    }
+
+    /// @brief Gets the command line of the current process.
+    /// @note /proc/self/cmdline is read once, on the first call from any thread, and split in place at its NUL
+    ///       separators. The views stay valid until the process exits. Throws WhispArgException if the command line
+    ///       cannot be read, such as on systems without /proc.
+    static const std::vector<std::string_view> &ProcessArguments()
+    {
+        // The buffer is built in place, so the views into it are never invalidated by a move.
+        struct CommandLine
+        {
+            std::string Buffer;
+            std::vector<std::string_view> Arguments;
+
+            CommandLine()
+            {
+                auto stream = std::ifstream("/proc/self/cmdline", std::ios::binary);
+                if (!stream)
+                {
+                    throw WhispArgException("The command line of the process is not available.");
+                }
+                // The size of files in /proc is not known in advance, so the file is read rather than mapped.
+                Buffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+                for (auto begin = std::size_t(0); begin < Buffer.size();)
+                {
+                    auto end = std::min(Buffer.find('\0', begin), Buffer.size());
+                    Arguments.push_back(std::string_view(Buffer).substr(begin, end - begin));
+                    begin = end + 1;
+                }
+            }
+
+            CommandLine(const CommandLine &) = delete;
+            CommandLine &operator=(const CommandLine &) = delete;
+        };
+        static const CommandLine commandLine;
+        return commandLine.Arguments;
+    }
+
+    /// @brief Parses an argument of the current process with a parser shared by the whole process.
+    /// @note Lets any component resolve its own options without argv being passed down to it. Thread-safe. The
+    ///       shared parser is created from FromProcess() on first use, and its help message and violations cover
+    ///       every argument parsed through it. See WithProcess() for other operations.
+    template <typename T> static Argument<T> ParseProcess(const Argument<T> &argument)
+    {
+        return WithProcess([&](WhispArg &parser) { return parser.Parse(argument); });
+    }
+
+    /// @brief Calls @c function with the parser shared by the whole process, while no other thread uses it.
+    /// @return The result of @c function.
+    template <typename Function> static auto WithProcess(Function function)
+    {
+        auto &shared = SharedProcessParser();
+        auto lock = std::lock_guard<std::mutex>(shared.Mutex);
+        return function(shared.Parser);
+    }
+
+    /// @brief Sets the description of the application.
+    WhispArg Description(const std::string &description)
+    {
+        _Description = description;
+        _HelpCache.clear();
+        return *this;
+    }
+
+    /// @brief Sets the name of the application.
+    WhispArg Name(const std::string &name)
+    {
+        _Name = name;
+        _HelpCache.clear();
+        return *this;
+    }
+
+    /// @brief Sets the version of the application.
+    WhispArg Version(const std::string &version)
+    {
+        _Version = version;
+        _HelpCache.clear();
+        return *this;
+    }
+
+    /// @brief Adds a profile that can be selected with --profile <name>.
+    WhispArg AddProfile(const Profile &profile)
+    {
+        _Profiles.push_back(profile);
+        _ProfileValues.reset();
+        return *this;
+    }
+
+#if defined(IDOFRONT__WHISPARG__POSIX)
+    /// @brief Appends the delimited tokens read from @c fd to the command line, as with --args-from-stdin.
+    /// @param fd The file descriptor to read from, such as STDIN_FILENO. It is not closed.
+    /// @param delimiter The character that terminates each token, typically '\n' or '\0' for `find -print0`.
+    /// @note The tokens are read with TokenStream until the end of the input, and are parsed as if they followed the
+    ///       arguments given to the constructor. Throws WhispArgException if the input cannot be read.
+    ///       See ArgumentsFromStdinArgument for the usual way to enable this.
+    WhispArg ArgumentsFrom(int fd, char delimiter = '\n')
+    {
+        auto stream = TokenStream(fd, delimiter);
+        auto token = std::string();
+        while (stream.Next(token))
+        {
+            _ArgumentValues.push_back(token);
+        }
+        // The token index and the profile values refer to the tokens, so they are built again.
+        _IsTokenPositionsBuilt = false;
+        _ProfileValues.reset();
+        return *this;
+    }
+#endif
+
+    /// @brief Reads values that are not given on the command line from a JSON config file.
+    /// @note The file is mapped into memory and each argument looks up its ConfigKey() on demand.
+    ///       Values in the config override profiles and defaults, and are overridden by the command line.
+    WhispArg Config(const std::string &path)
+    {
+        _Config = JsonSource::FromFile(path);
+        return *this;
+    }
+
+    /// @brief Reads values that are not given on the command line from a JSON source.
+    WhispArg Config(std::shared_ptr<const JsonSource> config)
+    {
+        _Config = std::move(config);
+        return *this;
+    }
+
+    /// @brief Enables the expansion of ${VAR} and ${arg:name} in argument values.
+    /// @note ${VAR} is replaced with the environment variable VAR, and ${arg:name} with the value of the argument
+    ///       "name", which may itself contain references. "$$" is replaced with "$", and a '$' that is not followed by
+    ///       '{' is kept as is. Values without '$' are used without copying.
+    ///       An argument can be referred to once it has been parsed or declared with Declare(). A declared argument is
+    ///       resolved from its own definition, so the result does not depend on the order the arguments are parsed in.
+    WhispArg Interpolate(bool isInterpolated)
+    {
+        _IsInterpolated = isInterpolated;
+        _InterpolatedValues.clear();
+        return *this;
+    }
+
+    /// @brief Declares an argument that ${arg:name} may refer to before it is parsed.
+    /// @note The value is looked up with the short name, flag-ness, config key and default value of @c argument, in the
+    ///       same sources as Parse().
+    template <typename T> WhispArg Declare(const Argument<T> &argument)
+    {
+        _ReferenceDefinitions.insert_or_assign(argument.Name(), ReferenceDefinition::New(argument));
+        return *this;
+    }
+
+    /// @brief Enables the UTF-8 validation of string arguments and descriptions.
+    /// @note Each token of the command line is validated once, when the command line is indexed. Parse() then records a
+    ///       violation for a string-typed argument whose value is not valid UTF-8, naming the position of the token
+    ///       and the offset of the first invalid byte, and for an argument whose description is not valid UTF-8.
+    ///       Values from a config or a profile, or changed by interpolation, are validated when they are used.
+    WhispArg ValidateUtf8(bool isUtf8Validated)
+    {
+        _IsUtf8Validated = isUtf8Validated;
+        _IsTokenPositionsBuilt = false;
+        return *this;
+    }
+
+    /// @brief Sets the current time that relative timestamps such as "now-2h" are resolved against.
+    WhispArg Now(type::Timestamp::Clock::time_point now)
+    {
+        _Now = now;
+        return *this;
+    }
+
+    /// @brief Gets the current time that relative timestamps are resolved against.
+    /// @note The clock is read on the first call, so all arguments of one command line agree on "now".
+    type::Timestamp::Clock::time_point Now()
+    {
+        if (!_Now.has_value())
+        {
+            _Now = type::Timestamp::Clock::now();
+        }
+        return _Now.value();
+    }
+
+    /// @brief Parses command-line arguments based on the specified Argument object and returns
+    ///        an Argument object containing the parsed results.
+    /// @note The value is taken from the command line, then from the JSON config, then from the selected profile,
+    ///       then from the default value.
+    ///       The command line is indexed on the first call, so each argument is resolved without scanning it.
+    template <typename T> Argument<T> Parse(const Argument<T> &argument)
+    {
+        auto information = ArgumentInformation::New(argument);
+        _ArgumentInformations.push_back(information);
+        _HelpCache.clear();
+        _HelpIndex.clear();
+
+        auto isFlag = std::is_same_v<T, type::Flag>;
+        auto isCommandLine = true;
+        auto value = FindCommandLineValue(argument.NameView(), argument.ShortNameView(), isFlag);
+        auto valuePosition = _ValuePosition;
+        if (!value.has_value() && _Config)
+        {
+            value = _Config->Find(argument.ConfigKey());
+            isCommandLine = false;
+        }
+        if (!value.has_value())
+        {
+            value = FindProfileValue(argument.NameView());
+            isCommandLine = false;
+        }
+        if (_IsInterpolated)
+        {
+            _ReferenceDefinitions.insert_or_assign(argument.Name(), ReferenceDefinition::New(argument));
+            if (value.has_value() && value.value().find('$') != std::string::npos)
+            {
+                auto stack = std::vector<std::string>{argument.Name()};
+                value = Expand(value.value(), stack);
+                valuePosition = std::string::npos;
+            }
+            RecordInterpolatedValue(argument, value);
+        }
+        if (_IsUtf8Validated)
+        {
+            CheckUtf8(argument, value, valuePosition);
+        }
+
+        if (!value.has_value() || value.value().empty())
+        {
+            if (argument.IsRequired())
+            {
+                throw WhispArgException("Argument \"" + argument.Name() + "\" is required.");
+            }
+            RecordResolvedValue(argument, std::nullopt);
+            // The default value is stored as the value, so that Get() does not have to fall back to it.
+            // A default type::OutputFile is not opened, since the user did not ask for that file to be written.
+            return Argument<T>::Update(argument, argument.Default());
+        }
+
+        auto parsed = Convert(argument, value.value(), isCommandLine);
+        auto violations = argument.Violations(parsed.Value().value());
+        _Violations.insert(_Violations.end(), violations.begin(), violations.end());
+        if constexpr (std::is_same_v<T, type::OutputFile>)
+        {
+            auto file = parsed.Get();
+            OpenOutputFile(argument, file);
+            parsed = Argument<T>::Update(parsed, file);
+        }
+        if constexpr (std::is_same_v<T, type::Flag>)
+        {
+            RecordResolvedValue(argument, parsed.Get().ToString());
+        }
+        else
+        {
+            RecordResolvedValue(argument, std::move(value));
+        }
+        return parsed;
+    }
+
+    /// @brief Builds a command line that gives the values resolved by Parse() to a child process.
+    /// @param overrides Values that replace the resolved values or are added after them, by argument name.
+    ///                  For a flag, the value is "true" or "false".
+    /// @note The program name is followed by "--name value" for each argument that got a value from the command line,
+    ///       the config or a profile, in the order they were parsed. A flag is given as "--name" if its value differs
+    ///       from the default value. Other tokens of the original command line are not included.
+    ArgumentVector ToArgv(const std::vector<std::pair<std::string, std::string>> &overrides = {}) const
+    {
+        auto findOverride = [&](std::string_view name) {
+            return std::find_if(overrides.begin(), overrides.end(),
+                                [&](const auto &entry) { return entry.first == name; });
+        };
+        auto isParsed = [&](const std::string &name) {
+            return std::any_of(_ResolvedValues.begin(), _ResolvedValues.end(),
+                               [&](const ResolvedValue &resolved) { return resolved.Name == name; });
+        };
+
+        return ArgumentVector::Build([&](auto token) {
+            token(_ArgumentValues.empty() ? std::string_view() : std::string_view(_ArgumentValues[0]), "");
+            for (const auto &resolved : _ResolvedValues)
+            {
+                auto overridden = findOverride(resolved.Name);
+                if (overridden == overrides.end() && !resolved.Value.has_value())
+                {
+                    continue;
+                }
+                const auto &value = overridden == overrides.end() ? resolved.Value.value() : overridden->second;
+                if (!resolved.IsFlag)
+                {
+                    token("--", resolved.Name);
+                    token(value, "");
+                }
+                else if ((value == "true") != resolved.FlagDefault)
+                {
+                    token("--", resolved.Name);
+                }
+            }
+            for (const auto &entry : overrides)
+            {
+                if (!isParsed(entry.first) && &*findOverride(entry.first) == &entry)
+                {
+                    token("--", entry.first);
+                    token(entry.second, "");
+                }
+            }
+        });
+    }
+
+    /// @brief Gets the constraint violations found by Parse() so far.
+    const std::vector<std::string> &Violations() const
+    {
+        return _Violations;
+    }
+
+    /// @brief Throws a WhispArgException that lists all constraint violations, if there are any.
+    /// @note Parse() does not throw for values that violate constraints, so that all of them can be reported at once.
+    ///       Call this after parsing all arguments.
+    ///       If there are no violations, the files of type::OutputFile arguments are created, truncated and reserved
+    ///       here, see type::OutputFile::Commit(), and the first one that fails is thrown.
+    void Validate() const
+    {
+        if (_Violations.empty())
+        {
+            std::for_each(_OutputFiles.begin(), _OutputFiles.end(),
+                          [](const type::OutputFile &file) { file.Commit(); });
+            return;
+        }
+        auto message = _Violations.front();
+        std::for_each(std::next(_Violations.begin()), _Violations.end(),
+                      [&](const std::string &violation) { message += "\n" + violation; });
+        throw WhispArgException(message);
+    }
+
+    /// @brief Displays a help message based on the Argument objects that have been parsed so far.
+    /// @note The width of the terminal is used as the maximum width. See TerminalWidth().
+    ///       If the command line contains --help=<topic>, only the arguments matching the topic are displayed.
+    void ShowHelp()
+    {
+        auto topic = HelpTopic();
+        if (topic.has_value())
+        {
+            ShowHelp(TerminalWidth(), topic.value());
+        }
+        else
+        {
+            ShowHelp(TerminalWidth());
+        }
+    }
+
+    /// @brief Displays the help message for the arguments that match a topic.
+    /// @param maxWidth The maximum width of the help message.
+    /// @param topic "all", a section name or a keyword. See HelpString(std::size_t, const std::string &).
+    void ShowHelp(std::size_t maxWidth, const std::string &topic)
+    {
+        auto help = HelpString(maxWidth, topic);
+        std::cout.write(help.data(), static_cast<std::streamsize>(help.size()));
+        std::cout << std::flush;
+    }
+
+    /// @brief Gets the topic given by --help=<topic> on the command line.
+    /// @note Returns std::nullopt if --help=<topic> is not given. If it is given more than once, the last one is used.
+    std::optional<std::string> HelpTopic() const
+    {
+        const auto prefix = std::string("--help=");
+        for (auto it = _ArgumentValues.rbegin(); it != _ArgumentValues.rend(); it++)
+        {
+            if (it->compare(0, prefix.size(), prefix) == 0)
+            {
+                return it->substr(prefix.size());
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// @brief Gets the help message for the arguments that match a topic.
+    /// @param maxWidth The maximum width of the help message.
+    /// @param topic "all" lists every argument including advanced ones. A section name, compared case-insensitively,
+    ///              lists the arguments of that section. Otherwise, the topic is a keyword and lists the arguments
+    ///              whose name, short name, section or description contains it as a word.
+    /// @note Keywords are looked up in an index over the words of all arguments, which is built on first use, so only
+    ///       the matching arguments are laid out.
+    std::string HelpString(std::size_t maxWidth, const std::string &topic)
+    {
+        auto key = ToLowerCase(topic);
+        auto indices = std::vector<std::size_t>();
+        if (key == "all")
+        {
+            indices.resize(_ArgumentInformations.size());
+            std::iota(indices.begin(), indices.end(), std::size_t(0));
+        }
+        else
+        {
+            for (auto index = std::size_t(0); index < _ArgumentInformations.size(); index++)
+            {
+                if (!_ArgumentInformations[index].Section().empty() &&
+                    ToLowerCase(_ArgumentInformations[index].Section()) == key)
+                {
+                    indices.push_back(index);
+                }
+            }
+        }
+
+        if (indices.empty())
+        {
+            if (_HelpIndex.empty())
+            {
+                BuildHelpIndex();
+            }
+            auto found = _HelpIndex.find(key);
+            if (found != _HelpIndex.end())
+            {
+                indices = found->second;
+            }
+        }
+
+        auto footer = indices.empty() ? "No options match \"" + topic + "\"." : std::string();
+        return LayoutHelp(maxWidth, indices, footer);
+    }
+
+    /// @brief Displays a help message based on the Argument objects that have been parsed so far.
+    /// @param maxWidth The maximum width of the help message.
+    void ShowHelp(std::size_t maxWidth)
+    {
+        const auto &help = HelpString(maxWidth);
+        std::cout.write(help.data(), static_cast<std::streamsize>(help.size()));
+        std::cout << std::flush;
+    }
+
+    /// @brief Gets the help message based on the Argument objects that have been parsed so far.
+    /// @param maxWidth The maximum width of the help message.
+    /// @note Advanced arguments are omitted. See Argument::IsAdvanced.
+    ///       The message laid out for the last width is cached until an argument is parsed or the application
+    ///       information is changed, so showing help repeatedly only writes the cached text.
+    const std::string &HelpString(std::size_t maxWidth)
+    {
+        if (_HelpCache.empty() || _HelpCacheWidth != maxWidth)
+        {
+            auto indices = std::vector<std::size_t>();
+            for (auto index = std::size_t(0); index < _ArgumentInformations.size(); index++)
+            {
+                if (!_ArgumentInformations[index].IsAdvanced())
+                {
+                    indices.push_back(index);
+                }
+            }
+            auto footer = indices.size() < _ArgumentInformations.size() ? "Use --help=all to show all options."
+                                                                         : std::string();
+            _HelpCache = LayoutHelp(maxWidth, indices, footer);
+            _HelpCacheWidth = maxWidth;
+        }
+        return _HelpCache;
+    }
+
+    /// @brief Checks whether the command line requests the schema with --whisparg-schema.
+    bool IsSchemaRequested() const
+    {
+        return std::find(_ArgumentValues.begin(), _ArgumentValues.end(), "--whisparg-schema") != _ArgumentValues.end();
+    }
+
+    /// @brief Gets a JSON document describing the application and the Argument objects that have been parsed so far.
+    /// @note Each argument lists its name, short name, JSON type, C++ value type, description, whether it is required
+    ///       or a flag, its default value, section and whether it is advanced. The type names are compile-time
+    ///       constants. See TypeName().
+    std::string Schema() const
+    {
+        auto applicationName = std::filesystem::path(_Name.empty() ? _ArgumentValues[0] : _Name).filename().string();
+        auto schema = std::string("{");
+        schema += "\"name\":\"" + EscapeJson(applicationName) + "\"";
+        schema += ",\"version\":\"" + EscapeJson(_Version) + "\"";
+        schema += ",\"description\":\"" + EscapeJson(_Description) + "\"";
+        schema += ",\"arguments\":[";
+        for (auto index = std::size_t(0); index < _ArgumentInformations.size(); index++)
+        {
+            schema += (index == 0 ? "" : ",") + _ArgumentInformations[index].ToJson();
+        }
+        schema += "]}";
+        return schema;
+    }
+
+    /// @brief Displays the schema. See Schema().
+    void ShowSchema() const
+    {
+        std::cout << Schema() << "\n" << std::flush;
+    }
+
+    /// @brief Gets the width of the terminal.
+    /// @note The width is detected once per process by DetectTerminalWidth().
+    static std::size_t TerminalWidth()
+    {
+        static const auto width = DetectTerminalWidth();
+        return width;
+    }
+
+    /// @brief Detects the width of the terminal.
+    /// @return The width of the terminal connected to the standard output, the value of the COLUMNS environment
+    ///         variable if the standard output is not a terminal, or 80 if neither is available.
+    static std::size_t DetectTerminalWidth()
+    {
+#if defined(IDOFRONT__WHISPARG__POSIX)
+        struct winsize size;
+        if (::isatty(STDOUT_FILENO) && ::ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_col > 0)
+        {
+            return size.ws_col;
+        }
+#endif
+        auto columns = std::getenv("COLUMNS");
+        if (columns != nullptr)
+        {
+            auto width = std::strtoul(columns, nullptr, 10);
+            if (width > 0)
+            {
+                return width;
+            }
+        }
+        return 80;
+    }
+
+  private:
+    std::vector<std::string> _ArgumentValues;
+    std::vector<ArgumentInformation> _ArgumentInformations;
+    std::string _Description;
+    std::string _Name;
+    std::string _Version;
+    std::string _HelpCache;
+    std::size_t _HelpCacheWidth = 0;
+    /// @brief Maps each token that starts with '-' to its positions on the command line, in ascending order.
+    std::unordered_map<std::string, std::vector<std::size_t>> _TokenPositions;
+    bool _IsTokenPositionsBuilt = false;
+    /// @brief The position on the command line of the value last found by FindCommandLineValue(), or npos.
+    std::size_t _ValuePosition = std::string::npos;
+    bool _IsUtf8Validated = false;
+    /// @brief Describes the first invalid byte of each token that is not valid UTF-8, by position on the command line.
+    std::unordered_map<std::size_t, std::string> _InvalidUtf8Tokens;
+    std::vector<Profile> _Profiles;
+    /// @brief The values of the selected profile by argument name, resolved on first use.
+    std::optional<std::unordered_map<std::string_view, std::string_view>> _ProfileValues;
+    /// @brief Shared by copies of the parser, since the source is read-only.
+    std::shared_ptr<const JsonSource> _Config;
+    std::vector<std::string> _Violations;
+    /// @brief The output files checked by Parse(), committed by Validate(). Copies share the descriptor.
+    std::vector<type::OutputFile> _OutputFiles;
+    /// @brief The value that Parse() found for an argument, as text.
+    struct ResolvedValue
+    {
+        std::string Name;
+        bool IsFlag;
+        bool FlagDefault;
+        /// @brief std::nullopt if the default value was used.
+        std::optional<std::string> Value;
+    };
+    /// @brief The values found by Parse(), in the order the arguments were parsed. Used by ToArgv().
+    std::vector<ResolvedValue> _ResolvedValues;
+
+    template <typename T> void RecordResolvedValue(const Argument<T> &argument, std::optional<std::string> value)
+    {
+        auto resolved = ResolvedValue{argument.Name(), std::is_same_v<T, type::Flag>, false, std::move(value)};
+        if constexpr (std::is_same_v<T, type::Flag>)
+        {
+            resolved.FlagDefault = argument.Default().value_or(type::Flag::False);
+        }
+        auto found = std::find_if(_ResolvedValues.begin(), _ResolvedValues.end(),
+                                  [&](const ResolvedValue &entry) { return entry.Name == resolved.Name; });
+        if (found == _ResolvedValues.end())
+        {
+            _ResolvedValues.push_back(std::move(resolved));
+        }
+        else
+        {
+            *found = std::move(resolved);
+        }
+    }
+
+    /// @brief What ${arg:name} needs to know to find the value of an argument that has not been parsed yet.
+    struct ReferenceDefinition
+    {
+        std::string ShortName;
+        bool IsFlag;
+        std::string ConfigKey;
+        /// @brief Formats the default value. It is only called when no source gives a value, so that a DefaultFrom()
+        ///        factory is not run needlessly.
+        std::function<std::optional<std::string>()> DefaultValue;
+
+        template <typename T> static ReferenceDefinition New(const Argument<T> &argument)
+        {
+            // The copy shares the default factory of the argument, so the factory still runs at most once.
+            return ReferenceDefinition{argument.ShortName(), std::is_same_v<T, type::Flag>, argument.ConfigKey(),
+                                       [argument]() { return DefaultString(argument); }};
+        }
+    };
+
+    bool _IsInterpolated = false;
+    std::optional<type::Timestamp::Clock::time_point> _Now;
+    /// @brief The expanded values of arguments by name, for ${arg:name}.
+    std::unordered_map<std::string, std::string> _InterpolatedValues;
+    /// @brief The definitions of the arguments that have been declared or parsed, by name.
+    std::unordered_map<std::string, ReferenceDefinition> _ReferenceDefinitions;
+    /// @brief The buffer that expansions are written to. A nested expansion is appended after the one that refers to
+    ///       it and removed when it is done, so the buffer is only allocated as it grows.
+    std::string _InterpolationArena;
+
+    explicit WhispArg(std::vector<std::string> argumentValues)
+        : _ArgumentValues(std::move(argumentValues)), _ArgumentInformations(), _Description()
+    {
+    }
+
+    /// @brief Gets the parser shared by the whole process, creating it on first use.
+    static auto &SharedProcessParser()
+    {
+        struct SharedParser
+        {
+            std::mutex Mutex;
+            WhispArg Parser = WhispArg::FromProcess();
+        };
+        static SharedParser shared;
+        return shared;
+    }
+
+    /// @brief Records violations for a description or a string value that is not valid UTF-8.
+    /// @param position The position of the value on the command line, which was validated when the command line was
+    ///                 indexed, or npos if the value has to be validated here.
+    template <typename T>
+    void CheckUtf8(const Argument<T> &argument, const std::optional<std::string> &value, std::size_t position)
+    {
+        auto invalidDescription = DescribeInvalidUtf8(argument.DescriptionView());
+        if (invalidDescription.has_value())
+        {
+            _Violations.push_back("Description of argument \"" + argument.Name() +
+                                  "\" is not valid UTF-8: " + invalidDescription.value() + ".");
+        }
+        if constexpr (JsonTypeName<T>() == "string")
+        {
+            if (!value.has_value())
+            {
+                return;
+            }
+            if (position != std::string::npos)
+            {
+                auto found = _InvalidUtf8Tokens.find(position);
+                if (found != _InvalidUtf8Tokens.end())
+                {
+                    _Violations.push_back("Argument \"" + argument.Name() + "\" is not valid UTF-8: " + found->second +
+                                          " of token " + std::to_string(position) + ".");
+                }
+                return;
+            }
+            auto invalid = DescribeInvalidUtf8(value.value());
+            if (invalid.has_value())
+            {
+                _Violations.push_back("Argument \"" + argument.Name() + "\" is not valid UTF-8: " + invalid.value() +
+                                      ".");
+            }
+        }
+    }
+
+    /// @brief Checks an output file, recording the reason as a violation if it cannot be opened.
+    /// @note The file is committed by Validate(), so an invalid command line leaves the file system untouched.
+    void OpenOutputFile(const Argument<type::OutputFile> &argument, type::OutputFile &file)
+    {
+        try
+        {
+            file.Check(argument.OutputOptions());
+            _OutputFiles.push_back(file);
+        }
+        catch (const WhispArgException &e)
+        {
+            _Violations.push_back("Argument \"" + argument.Name() + "\": " + e.what());
+        }
+    }
+
+    /// @brief Converts a value found by Parse().
+    /// @param isCommandLine Whether the value was given on the command line, which matters for flags.
+    template <typename T> Argument<T> Convert(const Argument<T> &argument, const std::string &value, bool isCommandLine)
+    {
+        try
+        {
+            if constexpr (std::is_same_v<T, type::Flag>)
+            {
+                // A flag on the command line inverts the default value, while other sources give the value itself.
+                if (!isCommandLine)
+                {
+                    auto flag = AutomaticConverter(Argument<bool>::New(argument.Name()))(value);
+                    return Argument<T>::Update(argument, type::Flag(flag));
+                }
+            }
+            if constexpr (std::is_same_v<T, type::Timestamp>)
+            {
+                return Argument<T>::Update(argument, type::Timestamp::Parse(value, Now()));
+            }
+            return Argument<T>::Update(argument, AutomaticConverter(argument)(value));
+        }
+        catch (const std::exception &e)
+        {
+            throw WhispArgException("Failed to parse the argument \"" + argument.Name() + "\": " + e.what());
+        }
+    }
+
+    /// @brief Remembers the value of a parsed argument, or its default value, for ${arg:name}.
+    template <typename T>
+    void RecordInterpolatedValue(const Argument<T> &argument, const std::optional<std::string> &value)
+    {
+        // As in Parse(), an empty value falls back to the default value.
+        auto recorded = value.has_value() && !value.value().empty() ? value : DefaultString(argument);
+        if (recorded.has_value())
+        {
+            _InterpolatedValues[argument.Name()] = std::move(recorded.value());
+        }
+    }
+
+    /// @brief Formats the default value of an argument, or returns std::nullopt if it has none.
+    template <typename T> static std::optional<std::string> DefaultString(const Argument<T> &argument)
+    {
+        if constexpr (IsStreamable<T>::value)
+        {
+            if (argument.Default().has_value())
+            {
+                auto stream = std::ostringstream();
+                stream << argument.Default().value();
+                return stream.str();
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// @brief Expands the references in @c text.
+    /// @param stack The arguments being expanded, used to detect cycles.
+    std::string Expand(const std::string &text, std::vector<std::string> &stack)
+    {
+        auto start = _InterpolationArena.size();
+        auto position = std::size_t(0);
+        while (true)
+        {
+            auto dollar = text.find('$', position);
+            auto length = dollar == std::string::npos ? std::string::npos : dollar - position;
+            _InterpolationArena.append(text, position, length);
+            if (dollar == std::string::npos)
+            {
+                break;
+            }
+
+            if (dollar + 1 < text.size() && text[dollar + 1] == '$')
+            {
+                _InterpolationArena += '$';
+                position = dollar + 2;
+                continue;
+            }
+            if (dollar + 1 >= text.size() || text[dollar + 1] != '{')
+            {
+                _InterpolationArena += '$';
+                position = dollar + 1;
+                continue;
+            }
+
+            auto close = text.find('}', dollar + 2);
+            if (close == std::string::npos)
+            {
+                _InterpolationArena.resize(start);
+                throw WhispArgException("Unterminated reference in \"" + text + "\".");
+            }
+            auto reference = text.substr(dollar + 2, close - dollar - 2);
+            try
+            {
+                if (reference.compare(0, 4, "arg:") == 0)
+                {
+                    _InterpolationArena += ResolveReference(reference.substr(4), stack);
+                }
+                else
+                {
+                    auto variable = std::getenv(reference.c_str());
+                    if (variable == nullptr)
+                    {
+                        throw WhispArgException("Environment variable \"" + reference + "\" is not set.");
+                    }
+                    _InterpolationArena += variable;
+                }
+            }
+            catch (...)
+            {
+                _InterpolationArena.resize(start);
+                throw;
+            }
+            position = close + 1;
+        }
+
+        auto expanded = _InterpolationArena.substr(start);
+        _InterpolationArena.resize(start);
+        return expanded;
+    }
+
+    /// @brief Gets the expanded value of the argument @c name, expanding the arguments it refers to first.
+    const std::string &ResolveReference(const std::string &name, std::vector<std::string> &stack)
+    {
+        auto found = _InterpolatedValues.find(name);
+        if (found != _InterpolatedValues.end())
+        {
+            return found->second;
+        }
+        if (std::find(stack.begin(), stack.end(), name) != stack.end())
+        {
+            auto cycle = std::string();
+            for (const auto &entry : stack)
+            {
+                cycle += entry + " -> ";
+            }
+            throw WhispArgException("Circular reference: " + cycle + name + ".");
+        }
+
+        // The argument has not been parsed yet, so its value is looked up with its declared definition.
+        auto definition = _ReferenceDefinitions.find(name);
+        if (definition == _ReferenceDefinitions.end())
+        {
+            throw WhispArgException("Referenced argument \"" + name +
+                                    "\" is not declared. Parse it first or declare it with Declare().");
+        }
+        auto value = FindCommandLineValue(name, definition->second.ShortName, definition->second.IsFlag);
+        if (!value.has_value() && _Config)
+        {
+            value = _Config->Find(definition->second.ConfigKey);
+        }
+        if (!value.has_value())
+        {
+            value = FindProfileValue(name);
+        }
+        if (!value.has_value() || value.value().empty())
+        {
+            value = definition->second.DefaultValue();
+        }
+        if (!value.has_value())
+        {
+            throw WhispArgException("Referenced argument \"" + name + "\" has no value.");
+        }
+
+        if (value.value().find('$') != std::string::npos)
+        {
+            stack.push_back(name);
+            value = Expand(value.value(), stack);
+            stack.pop_back();
+        }
+        return _InterpolatedValues[name] = std::move(value.value());
+    }
+
+    /// @brief Finds the value of an argument on the command line.
+    /// @return The value, "true" for a flag that is present, or std::nullopt if the argument is not given.
+    /// @note Matches the same tokens as the Parse() function, using positions looked up in the token index.
+    std::optional<std::string> FindCommandLineValue(std::string_view name, std::string_view shortName, bool isFlag)
+    {
+        if (!_IsTokenPositionsBuilt)
+        {
+            _TokenPositions.clear();
+            _InvalidUtf8Tokens.clear();
+            for (auto i = std::size_t(0); i < _ArgumentValues.size(); i++)
+            {
+                if (_ArgumentValues[i].size() > 1 && _ArgumentValues[i][0] == '-')
+                {
+                    _TokenPositions[_ArgumentValues[i]].push_back(i);
+                }
+                if (_IsUtf8Validated)
+                {
+                    auto invalid = DescribeInvalidUtf8(_ArgumentValues[i]);
+                    if (invalid.has_value())
+                    {
+                        _InvalidUtf8Tokens.emplace(i, std::move(invalid.value()));
+                    }
+                }
+            }
+            _IsTokenPositionsBuilt = true;
+        }
+        _ValuePosition = std::string::npos;
+
+        auto positions = std::vector<std::size_t>();
+        auto key = std::string();
+        auto addPositions = [&](std::string_view prefix, std::string_view name) {
+            key.assign(prefix).append(name);
+            auto found = _TokenPositions.find(key);
+            if (found != _TokenPositions.end())
+            {
+                auto middle = positions.size();
+                positions.insert(positions.end(), found->second.begin(), found->second.end());
+                std::inplace_merge(positions.begin(), positions.begin() + middle, positions.end());
+            }
+        };
+        // As in Parse(), two-character tokens are short names and longer ones are long names.
+        if (shortName.size() == 1)
+        {
+            addPositions("-", shortName);
+        }
+        if (!name.empty())
+        {
+            addPositions("--", name);
+        }
+        if (positions.empty())
+        {
+            return std::nullopt;
+        }
+        if (isFlag)
+        {
+            return type::Flag::True.ToString();
+        }
+
+        // Only the last value is used, so it is copied once at the end.
+        auto consumedPosition = std::numeric_limits<std::size_t>::max();
+        for (auto position : positions)
+        {
+            if (position == consumedPosition)
+            {
+                continue;
+            }
+            if (position + 1 >= _ArgumentValues.size())
+            {
+                throw WhispArgException("Argument \"" + std::string(name) + "\" requires a value.");
+            }
+            consumedPosition = position + 1;
+        }
+        _ValuePosition = consumedPosition;
+        return _ArgumentValues[consumedPosition];
+    }
+
+    /// @brief Finds the value of an argument in the profile selected with --profile.
+    std::optional<std::string> FindProfileValue(std::string_view name)
+    {
+        if (_Profiles.empty())
+        {
+            return std::nullopt;
+        }
+        if (!_ProfileValues)
+        {
+            _ProfileValues.emplace();
+            auto selected = FindCommandLineValue(ProfileArgument.Name(), ProfileArgument.ShortName(), false);
+            if (selected.has_value() && !selected.value().empty())
+            {
+                auto profile = std::find_if(_Profiles.begin(), _Profiles.end(),
+                                            [&](const Profile &profile) { return profile.Name() == selected.value(); });
+                if (profile == _Profiles.end())
+                {
+                    throw WhispArgException("Profile \"" + selected.value() + "\" is not defined.");
+                }
+                for (const auto &entry : *profile)
+                {
+                    (*_ProfileValues)[entry.Name] = entry.Value;
+                }
+            }
+        }
+
+        auto found = _ProfileValues->find(name);
+        if (found == _ProfileValues->end())
+        {
+            return std::nullopt;
+        }
+        return std::string(found->second);
+    }
+    /// @brief Maps each lower-case word of the arguments to the indices of the arguments that contain it.
+    std::unordered_map<std::string, std::vector<std::size_t>> _HelpIndex;
+
+    static std::string ToLowerCase(std::string text)
+    {
+        std::transform(text.begin(), text.end(), text.begin(),
+                       [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+        return text;
+    }
+
+    /// @brief Builds the index of the words of the arguments for keyword lookups in the help message.
+    void BuildHelpIndex()
+    {
+        for (auto index = std::size_t(0); index < _ArgumentInformations.size(); index++)
+        {
+            const auto &information = _ArgumentInformations[index];
+            auto addWord = [&](const std::string &word) {
+                if (word.empty())
+                {
+                    return;
+                }
+                auto &indices = _HelpIndex[ToLowerCase(word)];
+                if (indices.empty() || indices.back() != index)
+                {
+                    indices.push_back(index);
+                }
+            };
+            auto addWords = [&](const std::string &text) {
+                auto word = std::string();
+                for (auto c : text)
+                {
+                    if (std::isalnum(static_cast<unsigned char>(c)))
+                    {
+                        word += c;
+                    }
+                    else
+                    {
+                        addWord(word);
+                        word.clear();
+                    }
+                }
+                addWord(word);
+            };
+
+            addWord(information.Name());
+            addWord(information.ShortName());
+            addWords(information.Name());
+            addWords(information.Section());
+            addWords(information.Description());
+        }
+    }
+
+    /// @brief Lays out the help message.
+    /// @param maxWidth The maximum width of the help message.
+    /// @param indices The indices of the arguments to list.
+    /// @param footer A line appended after the arguments, if not empty.
+    std::string LayoutHelp(std::size_t maxWidth, const std::vector<std::size_t> &indices,
+                           const std::string &footer) const
+    {
+        auto helpLines = std::vector<std::string>();
+
+        auto applicationName = std::filesystem::path(_Name.empty() ? _ArgumentValues[0] : _Name).filename().string();
+        auto versionString = _Version.empty() ? "" : " " + _Version;
+        auto firstLine = applicationName + versionString;
+        helpLines.push_back(firstLine);
+
+        if (!_Description.empty())
+        {
+            auto applicationSescriptions = WrapLines(_Description, maxWidth);
+            std::for_each(applicationSescriptions.begin(), applicationSescriptions.end(),
+                          [&](const std::string &line) { helpLines.push_back(line); });
+        }
+
+        helpLines.push_back("Usage: " + _ArgumentValues[0] + " [options]");
+
+        std::vector<std::tuple<std::string, std::string>> argumentHelps;
+        std::transform(indices.begin(), indices.end(), std::back_inserter(argumentHelps), [&](std::size_t index) {
+            const auto &information = _ArgumentInformations[index];
+            auto upperCaseName = std::string(information.Name());
+            std::transform(upperCaseName.begin(), upperCaseName.end(), upperCaseName.begin(),
+                           [](char const &c) { return std::toupper(c); });
+
+            auto helpString = "--" + information.Name() +
+                              (information.ShortName().empty() ? "" : " (-" + information.ShortName() + ")");
+            if (!information.IsFlag())
+            {
+                helpString += " <" + upperCaseName + ">";
+            }
+
+            return std::make_tuple(helpString, information.Description());
+        });
+
+        auto keysMaxLength = std::size_t(std::accumulate(argumentHelps.begin(), argumentHelps.end(), 0,
+                                                         [](std::size_t l, std::tuple<std::string, std::string> tuple) {
+                                                             auto helpString = std::get<0>(tuple);
+                                                             return std::max(l, helpString.size());
+                                                         }));
+
+        auto isOneLine = keysMaxLength < (maxWidth / 3);
+
+        auto layoutArgument = [&](const std::tuple<std::string, std::string> &tuple) {
+            auto helpString = std::get<0>(tuple);
+            auto description = std::get<1>(tuple);
+
+            auto leadingString = std::string("");
+            auto wrappedDescription = std::vector<std::string>();
+            auto indentWidth = std::size_t(0);
+            auto descriptionWidth = std::size_t(0);
 
-    auto getConverter = std::function<std::function<T(const std::string &)>(const Argument<T> &)>(
-        [](const Argument<T> &argument) -> std::function<T(const std::string &)> {
-            if constexpr (std::is_same_v<T, int8_t> || std::is_same_v<T, int16_t> || std::is_same_v<T, int32_t> ||
-                          std::is_same_v<T, int64_t>)
+            if (isOneLine)
             {
-                return [](const std::string &value) { return std::stoll(value); };
+                auto padding = std::string(keysMaxLength - helpString.size(), ' ');
+
+                descriptionWidth = maxWidth - keysMaxLength - 2;
+                indentWidth = keysMaxLength + 2;
+                leadingString = helpString + padding + "  ";
             }
-            else if constexpr (std::is_same_v<T, uint8_t> || std::is_same_v<T, uint16_t> ||
-                               std::is_same_v<T, uint32_t> || std::is_same_v<T, uint64_t>)
+            else
             {
-                return [](const std::string &value) { return std::stoull(value); };
+                helpLines.push_back(helpString);
+
+                indentWidth = std::size_t(maxWidth * (1.0 / 20.0));
+                descriptionWidth = maxWidth - indentWidth;
+                leadingString = std::string(indentWidth, ' ');
             }
-            else if constexpr (std::is_same_v<T, float>)
+            wrappedDescription = WrapLines(description, descriptionWidth);
+
+            if (wrappedDescription.size())
             {
-                return [](const std::string &value) { return std::stof(value); };
+                std::for_each(wrappedDescription.begin(), wrappedDescription.end(), [&](const std::string &line) {
+                    helpLines.push_back(leadingString + line);
+                    leadingString = std::string(indentWidth, ' ');
+                });
             }
-            else if constexpr (std::is_same_v<T, double>)
+            else
             {
-                return [](const std::string &value) { return std::stod(value); };
+                if (isOneLine)
+                {
+                    helpLines.push_back(leadingString);
+                }
             }
-            else if constexpr (std::is_same_v<T, long double>)
+        };
+
+        // Arguments without a section come first under "Options", followed by each section in order of appearance.
+        auto sections = std::vector<std::string>{""};
+        std::for_each(indices.begin(), indices.end(), [&](std::size_t index) {
+            const auto &section = _ArgumentInformations[index].Section();
+            if (std::find(sections.begin(), sections.end(), section) == sections.end())
             {
-                return [](const std::string &value) { return std::stold(value); };
+                sections.push_back(section);
             }
-            else if constexpr (std::is_same_v<T, std::string>)
+        });
+        for (const auto &section : sections)
+        {
+            auto isEmpty = std::none_of(indices.begin(), indices.end(), [&](std::size_t index) {
+                return _ArgumentInformations[index].Section() == section;
+            });
+            if (isEmpty && (!section.empty() || sections.size() > 1))
             {
-                return [](const std::string &value) { return value; };
+                continue;
             }
-            else if constexpr (std::is_same_v<T, bool>)
+
+            helpLines.push_back(section.empty() ? "Options:" : section + ":");
+            for (auto i = std::size_t(0); i < indices.size(); i++)
             {
-                return [](const std::string &value) {
-                    if (value == "true")
-                    {
-                        return true;
-                    }
-                    else if (value == "false")
-                    {
-                        return false;
-                    }
-                    else
-                    {
-                        try
-                        {
-                            auto integerValue = std::stoll(value);
-                            return static_cast<bool>(integerValue);
-                        }
-                        catch (const std::exception &e)
-                        {
-                            throw WhispArgException("Value must be either \"true\"(1) or \"false\"(0).");
-                        }
-                    }
-                };
+                if (_ArgumentInformations[indices[i]].Section() == section)
+                {
+                    layoutArgument(argumentHelps[i]);
+                }
             }
-            else if constexpr (std::is_same_v<T, type::Flag>)
+        }
+
+        if (!footer.empty())
+        {
+            helpLines.push_back(footer);
+        }
+
+        auto help = std::string();
+        help.reserve(std::accumulate(helpLines.begin(), helpLines.end(), std::size_t(0),
+                                     [](std::size_t size, const std::string &line) { return size + line.size() + 1; }));
+        std::for_each(helpLines.begin(), helpLines.end(), [&](const std::string &line) {
+            help += line;
+            help += '\n';
+        });
+        return help;
+    }
+
+    /// @brief Wraps text to the specified width.
+    /// @note Takes newline characters in @c text into account.
+    static std::vector<std::string> WrapLines(const std::string &text, size_t maxWidth)
+    {
+        std::vector<std::string> lines;
+        std::istringstream stream(text);
+        std::string line;
+
+        while (std::getline(stream, line))
+        {
+            auto partialLines = WrapLine(line, maxWidth);
+            std::copy(partialLines.begin(), partialLines.end(), std::back_inserter(lines));
+        }
+
+        return lines;
+    }
+
+    /// @brief Wraps text to the specified width.
+    /// @note Newline characters are ignored. If @c text may contain newline characters, WrapLines is recommended
+    /// instead. The width of UTF-8 text is its number of code points.
+    static std::vector<std::string> WrapLine(const std::string &text, size_t maxWidth)
+    {
+        std::vector<std::string> lines;
+        std::istringstream words(text);
+        std::string word;
+        std::string currentLine;
+        auto currentWidth = std::size_t(0);
+
+        while (words >> word)
+        {
+            auto wordWidth = CountCodePoints(word);
+            if (currentWidth + wordWidth + 1 <= maxWidth)
             {
-                return [&argument](const std::string &) { return !argument.Value().value(); };
+                if (!currentLine.empty())
+                {
+                    currentLine += " ";
+                    currentWidth++;
+                }
+                currentLine += word;
+                currentWidth += wordWidth;
             }
             else
             {
-                WhispArgException("Type not supported.");
+                if (!currentLine.empty())
+                {
+                    lines.push_back(currentLine);
+                }
+                currentLine = word;
+                currentWidth = wordWidth;
             }
-        });
+        }
 
-    auto converter = getConverter(argument);
+        if (!currentLine.empty())
+        {
+            lines.push_back(currentLine);
+        }
 
-    return Parse(argv, argument, converter);
-}
+        return lines;
+    }
+};
 
-/// @brief Parses command-line arguments for types that support automatic conversion.
-/// @tparam T The type of the command-line argument.
-/// @param argc The number of command-line arguments.
-/// @param argv The command-line arguments.
-/// @param argument The definition of the command-line argument.
-/// @return The value of the command-line argument (wrapped in std::optional).
-/// @note Ensures at compile time that the type is supported.
-template <typename T> std::optional<T> Parse(int argc, char *argv[], const Argument<T> &argument)
+/// @brief Reads the next token of a command line.
+/// @param line The command line.
+/// @param position The position to start reading from. It is advanced past the token that was read.
+/// @param token Receives the token. Its previous content is discarded.
+/// @return false if only whitespace remains.
+/// @note Whitespace separates tokens. Single and double quotes group characters, and a backslash escapes the next
+///       character outside single quotes. An unterminated quote runs to the end of the line.
+inline bool NextToken(std::string_view line, std::size_t &position, std::string &token)
 {
-    return Parse(std::vector<std::string>(argv, argv + argc), argument);
+    auto isSpace = [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f'; };
+
+    while (position < line.size() && isSpace(line[position]))
+    {
+        position++;
+    }
+    if (position >= line.size())
+    {
+        return false;
+    }
+
+    token.clear();
+    auto quote = '\0';
+    for (; position < line.size(); position++)
+    {
+        auto c = line[position];
+        if (quote == '\'')
+        {
+            if (c == '\'')
+            {
+                quote = '\0';
+            }
+            else
+            {
+                token += c;
+            }
+        }
+        else if (c == '\\' && position + 1 < line.size())
+        {
+            token += line[++position];
+        }
+        else if (quote == '"')
+        {
+            if (c == '"')
+            {
+                quote = '\0';
+            }
+            else
+            {
+                token += c;
+            }
+        }
+        else if (c == '\'' || c == '"')
+        {
+            quote = c;
+        }
+        else if (isSpace(c))
+        {
+            break;
+        }
+        else
+        {
+            token += c;
+        }
+    }
+    return true;
 }
 
-/// @brief A preset Argument for the --help option.
-inline Argument<type::Flag> Help =
-    Argument<type::Flag>::New('h', "help").Description("Show help message.").Default(type::Flag::False);
+/// @brief Splits a command line into tokens.
+/// @note See NextToken for the quoting rules.
+inline std::vector<std::string> Tokenize(std::string_view line)
+{
+    auto tokens = std::vector<std::string>();
+    auto position = std::size_t(0);
+    auto token = std::string();
+    while (NextToken(line, position, token))
+    {
+        tokens.push_back(token);
+    }
+    return tokens;
+}
 
-/// @brief A class that holds information about a command-line argument.
-class ArgumentInformation
+/// @brief A diagnostic reported for one line of a batch.
+class BatchDiagnostic
 {
   public:
-    /// @brief Creates an ArgumentInformation object from an Argument object.
-    template <typename T> static ArgumentInformation New(const Argument<T> &argument)
+    /// @brief Constructs a BatchDiagnostic object.
+    BatchDiagnostic(std::size_t line, const std::string &message) : _Line(line), _Message(message)
     {
-        auto isFlag = std::is_same_v<T, type::Flag>;
-        return ArgumentInformation(argument.Name(), argument.ShortName(), argument.Description(), isFlag,
-                                   argument.IsRequired());
     }
 
-    /// @brief Constructs an ArgumentInformation object.
-    ArgumentInformation(const std::string &name, const std::string &shortName, const std::string &description,
-                        bool isFlag, bool isRequired)
-        : _Name(name), _ShortName(shortName), _Description(description), _IsFlag(isFlag), _IsRequired(isRequired)
+    /// @brief The zero-based index of the line.
+    std::size_t Line() const
     {
+        return _Line;
     }
 
-    /// @brief Name.
-    std::string Name() const
+    /// @brief The error message.
+    std::string Message() const
+    {
+        return _Message;
+    }
+
+  private:
+    std::size_t _Line;
+    std::string _Message;
+};
+
+/// @brief A column of BatchParser, holding the definition of one argument and the values parsed for it.
+class BatchColumnBase
+{
+  public:
+    virtual ~BatchColumnBase() = default;
+
+    /// @brief Gets the name of the argument.
+    virtual const std::string &Name() const = 0;
+
+    /// @brief Gets the short name of the argument.
+    virtual const std::string &ShortName() const = 0;
+
+    /// @brief Whether the argument is a flag.
+    virtual bool IsFlag() const = 0;
+
+    /// @brief Creates an empty column with the same definition and @c rows values.
+    virtual std::unique_ptr<BatchColumnBase> Clone(std::size_t rows) const = 0;
+
+    /// @brief Stores the value of a row.
+    /// @param row The index of the row.
+    /// @param value The value token, or nullptr if the argument was not given.
+    /// @note Throws WhispArgException if the value cannot be converted or a required argument is missing.
+    virtual void Store(std::size_t row, const std::string *value) = 0;
+};
+
+/// @brief A typed column of BatchParser.
+/// @tparam T The type of the command-line argument.
+template <typename T> class BatchColumn : public BatchColumnBase
+{
+  public:
+    /// @brief Constructs a column from an argument definition.
+    BatchColumn(const Argument<T> &argument, std::size_t rows)
+        : _Argument(argument), _Name(argument.Name()), _ShortName(argument.ShortName()),
+          _Converter(AutomaticConverter(_Argument)), _Values(rows)
+    {
+    }
+
+    const std::string &Name() const override
     {
         return _Name;
     }
 
-    /// @brief Short name.
-    std::string ShortName() const
+    const std::string &ShortName() const override
     {
         return _ShortName;
     }
 
-    /// @brief Description.
-    std::string Description() const
+    bool IsFlag() const override
     {
-        return _Description;
+        return std::is_same_v<T, type::Flag>;
+    }
+
+    std::unique_ptr<BatchColumnBase> Clone(std::size_t rows) const override
+    {
+        return std::make_unique<BatchColumn<T>>(_Argument, rows);
     }
 
-    /// @brief Whether it is a flag.
-    bool IsFlag() const
-    {
-        return _IsFlag;
+    void Store(std::size_t row, const std::string *value) override
+    {
+        if (value == nullptr || value->empty())
+        {
+            if (_Argument.IsRequired())
+            {
+                throw WhispArgException("Argument \"" + _Name + "\" is required.");
+            }
+            _Values[row] = _Argument.Default();
+            return;
+        }
+
+        // The value is only stored once it has been validated, so that a row with a diagnostic stays std::nullopt.
+        auto converted = std::optional<T>();
+        try
+        {
+            converted = _Converter(*value);
+        }
+        catch (const std::exception &e)
+        {
+            throw WhispArgException("Failed to parse the argument \"" + _Name + "\": " + e.what());
+        }
+
+        auto violations = _Argument.Violations(converted.value());
+        if (!violations.empty())
+        {
+            throw WhispArgException(violations.front());
+        }
+        _Values[row] = std::move(converted);
     }
 
-    /// @brief Whether it is required.
-    bool IsRequired() const
+    /// @brief Gets the values of all rows.
+    const std::vector<std::optional<T>> &Values() const
     {
-        return _IsRequired;
+        return _Values;
     }
 
   private:
+    Argument<T> _Argument;
     std::string _Name;
     std::string _ShortName;
-    std::string _Description;
-    bool _IsFlag;
-    bool _IsRequired;
+    std::function<T(const std::string &)> _Converter;
+    std::vector<std::optional<T>> _Values;
 };
 
-/// @brief A class that parses command-line arguments.
-/// @note Although you can parse arguments using the Parse() function directly,
-///       using the WhispArg class allows you to generate help messages from multiple command-line arguments.
-class WhispArg
+/// @brief Columnar results of BatchParser.
+class BatchResult
 {
   public:
-    /// @brief Constructs a WhispArg object to parse command-line arguments.
-    WhispArg(int argc, char *argv[])
-        : _ArgumentValues(std::vector<std::string>(argv, argv + argc)), _ArgumentInformations(), _Description()
+    /// @brief The number of parsed lines.
+    std::size_t Rows() const
     {
+        return _Rows;
     }
 
-    /// @brief Sets the description of the application.
-    WhispArg Description(const std::string &description)
+    /// @brief Gets the values parsed for an argument, one per line.
+    /// @note A value is std::nullopt if the line did not give the argument and it has no default value, or if the
+    ///       line has a diagnostic for the argument.
+    template <typename T> const std::vector<std::optional<T>> &Column(const Argument<T> &argument) const
     {
-        _Description = description;
-        return *this;
+        for (const auto &column : _Columns)
+        {
+            if (column->Name() == argument.Name())
+            {
+                auto typedColumn = dynamic_cast<const BatchColumn<T> *>(column.get());
+                if (typedColumn == nullptr)
+                {
+                    throw WhispArgException("Argument \"" + argument.Name() + "\" has a different type.");
+                }
+                return typedColumn->Values();
+            }
+        }
+        throw WhispArgException("Argument \"" + argument.Name() + "\" is not part of the batch.");
     }
 
-    /// @brief Sets the name of the application.
-    WhispArg Name(const std::string &name)
+    /// @brief Gets the diagnostics of all lines, ordered by line.
+    const std::vector<BatchDiagnostic> &Diagnostics() const
     {
-        _Name = name;
-        return *this;
+        return _Diagnostics;
     }
 
-    /// @brief Sets the version of the application.
-    WhispArg Version(const std::string &version)
+  private:
+    friend class BatchParser;
+
+    std::size_t _Rows = 0;
+    std::vector<std::unique_ptr<BatchColumnBase>> _Columns;
+    std::vector<BatchDiagnostic> _Diagnostics;
+};
+
+/// @brief A class that parses many command lines with the same arguments.
+/// @note Each line of the input is one command line. Lines are split into tokens by Tokenize and are parsed on
+///       multiple threads. The parser is not modified while parsing, so one BatchParser can be shared.
+class BatchParser
+{
+  public:
+    /// @brief Adds an argument to be parsed on every line.
+    /// @note Only types that support automatic conversion can be used.
+    template <typename T> BatchParser Add(const Argument<T> &argument)
     {
-        _Version = version;
+        auto index = _Columns.size();
+        _Columns.push_back(std::make_shared<BatchColumn<T>>(argument, 0));
+        _Keys["--" + argument.Name()].push_back(index);
+        if (!argument.ShortName().empty())
+        {
+            _Keys["-" + argument.ShortName()].push_back(index);
+        }
         return *this;
     }
 
-    /// @brief Parses command-line arguments based on the specified Argument object and returns
-    ///        an Argument object containing the parsed results.
-    template <typename T> Argument<T> Parse(const Argument<T> &argument)
+    /// @brief Parses every line of a file.
+    /// @param path The path of the file.
+    /// @param threadCount The number of threads to use. 0 uses one thread per hardware thread.
+    BatchResult ParseFile(const std::string &path, std::size_t threadCount = 0) const
     {
-        auto information = ArgumentInformation::New(argument);
-        _ArgumentInformations.push_back(information);
-
-        auto result = ::idofront::whisparg::Parse(_ArgumentValues, argument);
-        return result.has_value() ? idofront::whisparg::Argument<T>::Update(argument, result) : argument;
+        auto file = MappedFile(path);
+        return Parse(file.View(), threadCount);
     }
 
-    /// @brief Displays a help message based on the Argument objects that have been parsed so far.
-    /// @param maxWidth The maximum width of the help message.
-    void ShowHelp(std::size_t maxWidth = 80)
+    /// @brief Parses every line of a text.
+    /// @param text The lines to parse.
+    /// @param threadCount The number of threads to use. 0 uses one thread per hardware thread.
+    BatchResult Parse(std::string_view text, std::size_t threadCount = 0) const
     {
-        auto helpLines = std::vector<std::string>();
-
-        auto applicationName = std::filesystem::path(_Name.empty() ? _ArgumentValues[0] : _Name).filename().string();
-        auto versionString = _Version.empty() ? "" : " " + _Version;
-        auto firstLine = applicationName + versionString;
-        helpLines.push_back(firstLine);
-
-        if (!_Description.empty())
+        auto lines = std::vector<std::string_view>();
+        for (auto begin = std::size_t(0); begin < text.size();)
         {
-            auto applicationSescriptions = WrapLines(_Description, maxWidth);
-            std::for_each(applicationSescriptions.begin(), applicationSescriptions.end(),
-                          [&](const std::string &line) { helpLines.push_back(line); });
+            auto end = text.find('\n', begin);
+            end = end == std::string_view::npos ? text.size() : end;
+            lines.push_back(text.substr(begin, end - begin));
+            begin = end + 1;
         }
 
-        helpLines.push_back("Usage: " + _ArgumentValues[0] + " [options]");
-        helpLines.push_back("Options:");
+        auto result = BatchResult();
+        result._Rows = lines.size();
+        std::transform(_Columns.begin(), _Columns.end(), std::back_inserter(result._Columns),
+                       [&](const std::shared_ptr<BatchColumnBase> &column) { return column->Clone(lines.size()); });
 
-        std::vector<std::tuple<std::string, std::string>> argumentHelps;
-        std::transform(_ArgumentInformations.begin(), _ArgumentInformations.end(), std::back_inserter(argumentHelps),
-                       [](const ArgumentInformation &information) {
-                           auto upperCaseName = std::string(information.Name());
-                           std::transform(upperCaseName.begin(), upperCaseName.end(), upperCaseName.begin(),
-                                          [](char const &c) { return std::toupper(c); });
-
-                           auto helpString =
-                               "--" + information.Name() +
-                               (information.ShortName().empty() ? "" : " (-" + information.ShortName() + ")");
-                           if (!information.IsFlag())
-                           {
-                               helpString += " <" + upperCaseName + ">";
-                           }
-
-                           return std::make_tuple(helpString, information.Description());
-                       });
+        threadCount = threadCount == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threadCount;
+        threadCount = std::max(std::size_t(1), std::min(threadCount, lines.size()));
+        auto chunkSize = (lines.size() + threadCount - 1) / std::max(std::size_t(1), threadCount);
 
-        auto keysMaxLength = std::size_t(std::accumulate(argumentHelps.begin(), argumentHelps.end(), 0,
-                                                         [](std::size_t l, std::tuple<std::string, std::string> tuple) {
-                                                             auto helpString = std::get<0>(tuple);
-                                                             return std::max(l, helpString.size());
-                                                         }));
+        auto diagnostics = std::vector<std::vector<BatchDiagnostic>>(threadCount);
+        auto errors = std::vector<std::exception_ptr>(threadCount);
+        auto parseChunk = [&](std::size_t chunk) {
+            try
+            {
+                auto begin = std::min(lines.size(), chunk * chunkSize);
+                auto end = std::min(lines.size(), begin + chunkSize);
+                ParseLines(lines, begin, end, result._Columns, diagnostics[chunk]);
+            }
+            catch (...)
+            {
+                errors[chunk] = std::current_exception();
+            }
+        };
 
-        auto isOneLine = keysMaxLength < (maxWidth / 3);
+        auto threads = std::vector<std::thread>();
+        for (auto chunk = std::size_t(1); chunk < threadCount; chunk++)
+        {
+            threads.emplace_back(parseChunk, chunk);
+        }
+        parseChunk(0);
+        std::for_each(threads.begin(), threads.end(), [](std::thread &thread) { thread.join(); });
 
-        std::for_each(argumentHelps.begin(), argumentHelps.end(), [&](std::tuple<std::string, std::string> tuple) {
-            auto helpString = std::get<0>(tuple);
-            auto description = std::get<1>(tuple);
+        for (const auto &error : errors)
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+        for (auto &chunkDiagnostics : diagnostics)
+        {
+            std::move(chunkDiagnostics.begin(), chunkDiagnostics.end(), std::back_inserter(result._Diagnostics));
+        }
+        return result;
+    }
 
-            auto leadingString = std::string("");
-            auto wrappedDescription = std::vector<std::string>();
-            auto indentWidth = std::size_t(0);
-            auto descriptionWidth = std::size_t(0);
+  private:
+    std::vector<std::shared_ptr<BatchColumnBase>> _Columns;
+    std::unordered_map<std::string, std::vector<std::size_t>> _Keys;
 
-            if (isOneLine)
-            {
-                auto padding = std::string(keysMaxLength - helpString.size(), ' ');
+    /// @brief Parses the lines in [begin, end) into the columns.
+    /// @note Every token is looked up once, and matches the same way as Parse() does for each argument.
+    void ParseLines(const std::vector<std::string_view> &lines, std::size_t begin, std::size_t end,
+                    const std::vector<std::unique_ptr<BatchColumnBase>> &columns,
+                    std::vector<BatchDiagnostic> &diagnostics) const
+    {
+        const auto npos = std::numeric_limits<std::size_t>::max();
+        auto tokens = std::vector<std::string>();
+        auto valuePositions = std::vector<std::size_t>(columns.size());
+        auto consumedPositions = std::vector<std::size_t>(columns.size());
+        auto errors = std::vector<std::string>(columns.size());
+        auto token = std::string();
 
-                descriptionWidth = maxWidth - keysMaxLength - 2;
-                indentWidth = keysMaxLength + 2;
-                leadingString = helpString + padding + "  ";
+        for (auto row = begin; row < end; row++)
+        {
+            tokens.clear();
+            auto position = std::size_t(0);
+            while (NextToken(lines[row], position, token))
+            {
+                tokens.push_back(token);
             }
-            else
+
+            std::fill(valuePositions.begin(), valuePositions.end(), npos);
+            std::fill(consumedPositions.begin(), consumedPositions.end(), npos);
+            std::for_each(errors.begin(), errors.end(), [](std::string &error) { error.clear(); });
+
+            for (auto i = std::size_t(0); i < tokens.size(); i++)
             {
-                helpLines.push_back(helpString);
+                auto key = _Keys.find(tokens[i]);
+                if (key == _Keys.end())
+                {
+                    continue;
+                }
+                for (auto index : key->second)
+                {
+                    if (consumedPositions[index] == i || !errors[index].empty())
+                    {
+                        continue;
+                    }
+                    if (columns[index]->IsFlag())
+                    {
+                        valuePositions[index] = i;
+                    }
+                    else if (i + 1 < tokens.size())
+                    {
+                        valuePositions[index] = i + 1;
+                        consumedPositions[index] = i + 1;
+                    }
+                    else
+                    {
+                        errors[index] = "Argument \"" + columns[index]->Name() + "\" requires a value.";
+                    }
+                }
+            }
 
-                indentWidth = std::size_t(maxWidth * (1.0 / 20.0));
-                descriptionWidth = maxWidth - indentWidth;
-                leadingString = std::string(indentWidth, ' ');
+            for (auto index = std::size_t(0); index < columns.size(); index++)
+            {
+                if (!errors[index].empty())
+                {
+                    diagnostics.emplace_back(row, errors[index]);
+                    continue;
+                }
+                try
+                {
+                    auto flagValue = std::string("true");
+                    auto position = valuePositions[index];
+                    auto value = position == npos                ? nullptr
+                                 : columns[index]->IsFlag() ? &flagValue
+                                                            : &tokens[position];
+                    columns[index]->Store(row, value);
+                }
+                catch (const WhispArgException &e)
+                {
+                    diagnostics.emplace_back(row, e.what());
+                }
             }
-            wrappedDescription = WrapLines(description, descriptionWidth);
+        }
+    }
+};
 
-            if (wrappedDescription.size())
+/// @brief A class that re-parses a command line as it is edited, such as in an interactive shell.
+/// @note The parser keeps the tokens of the previous input. Only the tokens from the first changed one onwards are
+///       tokenized and validated again. Append() does not look at the rest of the line, so its cost does not grow with
+///       the length of the line. Update() first compares the whole common prefix, which is linear in the length of the
+///       line but much cheaper than tokenizing it again.
+///       Tokens match arguments the same way as Parse() does.
+class IncrementalParser
+{
+  public:
+    /// @brief Adds an argument to be recognized.
+    template <typename T> IncrementalParser Add(const Argument<T> &argument)
+    {
+        auto index = _Informations.size();
+        _Informations.push_back(ArgumentInformation::New(argument));
+        _Keys["--" + argument.Name()].push_back(index);
+        if (!argument.ShortName().empty())
+        {
+            _Keys["-" + argument.ShortName()].push_back(index);
+        }
+        _Matches.emplace_back();
+        return *this;
+    }
+
+    /// @brief Replaces the input with @c line.
+    /// @note The common prefix with the previous input is found with a single comparison, whose cost grows with the
+    ///       length of the prefix. Use Append() when the caller already knows that text was only added.
+    void Update(std::string_view line)
+    {
+        auto length = std::min(line.size(), _Line.size());
+        auto mismatch = std::mismatch(line.begin(), line.begin() + length, _Line.begin());
+        auto common = static_cast<std::size_t>(mismatch.first - line.begin());
+
+        DropTokensFrom(common);
+        _Line.replace(common, std::string::npos, line.substr(common));
+        TokenizeFrom(_Tokens.empty() ? 0 : _Tokens.back().End);
+    }
+
+    /// @brief Appends @c text to the input.
+    void Append(std::string_view text)
+    {
+        DropTokensFrom(_Line.size());
+        _Line.append(text);
+        TokenizeFrom(_Tokens.empty() ? 0 : _Tokens.back().End);
+    }
+
+    /// @brief Gets the current input.
+    const std::string &Line() const
+    {
+        return _Line;
+    }
+
+    /// @brief Gets the tokens of the current input.
+    std::vector<std::string> Tokens() const
+    {
+        auto tokens = std::vector<std::string>();
+        std::transform(_Tokens.begin(), _Tokens.end(), std::back_inserter(tokens),
+                       [](const TokenState &token) { return token.Text; });
+        return tokens;
+    }
+
+    /// @brief Gets the number of tokens that the last update tokenized.
+    std::size_t LastTokenizedCount() const
+    {
+        return _LastTokenizedCount;
+    }
+
+    /// @brief Gets the value of an argument in the current input.
+    /// @note Throws WhispArgException if the value cannot be converted, or if a required argument is missing or
+    ///       empty, as Parse() does.
+    template <typename T> std::optional<T> Value(const Argument<T> &argument) const
+    {
+        auto index = IndexOf(argument.Name());
+        const auto &matches = _Matches[index];
+        auto position = matches.empty() ? std::size_t(0) : matches.back();
+        auto value = matches.empty()                  ? std::string()
+                     : std::is_same_v<T, type::Flag> ? type::Flag::True.ToString()
+                     : position + 1 < _Tokens.size() ? _Tokens[position + 1].Text
+                                                     : std::string();
+        if (value.empty())
+        {
+            if (argument.IsRequired())
             {
-                std::for_each(wrappedDescription.begin(), wrappedDescription.end(), [&](const std::string &line) {
-                    helpLines.push_back(leadingString + line);
-                    leadingString = std::string(indentWidth, ' ');
-                });
+                throw WhispArgException("Argument \"" + argument.Name() + "\" is required.");
             }
-            else
+            return argument.Default();
+        }
+        auto converted = std::optional<T>();
+        try
+        {
+            converted = AutomaticConverter(argument)(value);
+        }
+        catch (const std::exception &e)
+        {
+            throw WhispArgException("Failed to parse the argument \"" + argument.Name() + "\": " + e.what());
+        }
+
+        auto violations = argument.Violations(converted.value());
+        if (!violations.empty())
+        {
+            throw WhispArgException(violations.front());
+        }
+        return converted;
+    }
+
+    /// @brief Gets the validation messages for the current input.
+    std::vector<std::string> Diagnostics() const
+    {
+        auto diagnostics = std::vector<std::string>();
+        std::transform(_UnknownTokens.begin(), _UnknownTokens.end(), std::back_inserter(diagnostics),
+                       [&](std::size_t index) { return "Unknown argument \"" + _Tokens[index].Text + "\"."; });
+        if (!_Tokens.empty())
+        {
+            for (auto index : _Tokens.back().Matched)
             {
-                if (isOneLine)
+                if (!_Informations[index].IsFlag())
                 {
-                    helpLines.push_back(leadingString);
+                    diagnostics.push_back("Argument \"" + _Informations[index].Name() + "\" requires a value.");
                 }
             }
-        });
+        }
+        for (auto index = std::size_t(0); index < _Informations.size(); index++)
+        {
+            if (_Informations[index].IsRequired() && _Matches[index].empty())
+            {
+                diagnostics.push_back("Argument \"" + _Informations[index].Name() + "\" is required.");
+            }
+        }
+        return diagnostics;
+    }
 
-        std::for_each(helpLines.begin(), helpLines.end(), [](const std::string &line) {
-            std::cout << line << "\n" << std::flush;
-        });
+    /// @brief Gets the arguments that complete the token under the cursor at the end of the input.
+    /// @return The long names, prefixed with "--", of the arguments that start with the last token.
+    std::vector<std::string> Candidates() const
+    {
+        auto candidates = std::vector<std::string>();
+        if (_Tokens.empty() || _Tokens.back().End != _Line.size() || _Tokens.back().Text.empty() ||
+            _Tokens.back().Text[0] != '-')
+        {
+            return candidates;
+        }
+
+        const auto &prefix = _Tokens.back().Text;
+        for (const auto &information : _Informations)
+        {
+            auto key = "--" + information.Name();
+            if (key.compare(0, prefix.size(), prefix) == 0)
+            {
+                candidates.push_back(key);
+            }
+        }
+        return candidates;
     }
 
   private:
-    std::vector<std::string> _ArgumentValues;
-    std::vector<ArgumentInformation> _ArgumentInformations;
-    std::string _Description;
-    std::string _Name;
-    std::string _Version;
-
-    /// @brief Wraps text to the specified width.
-    /// @note Takes newline characters in @c text into account.
-    static std::vector<std::string> WrapLines(const std::string &text, size_t maxWidth)
+    /// @brief A token and the validation state that follows from it.
+    struct TokenState
     {
-        std::vector<std::string> lines;
-        std::istringstream stream(text);
-        std::string line;
+        std::size_t End;
+        std::string Text;
+        /// @brief The indices of the arguments that this token matched.
+        std::vector<std::size_t> Matched;
+    };
 
-        while (std::getline(stream, line))
+    std::vector<ArgumentInformation> _Informations;
+    std::unordered_map<std::string, std::vector<std::size_t>> _Keys;
+    std::string _Line;
+    std::vector<TokenState> _Tokens;
+    /// @brief The positions of the tokens that matched each argument, in ascending order.
+    std::vector<std::vector<std::size_t>> _Matches;
+    /// @brief The positions of unknown options, in ascending order.
+    std::vector<std::size_t> _UnknownTokens;
+    std::size_t _LastTokenizedCount = 0;
+
+    std::size_t IndexOf(const std::string &name) const
+    {
+        for (auto index = std::size_t(0); index < _Informations.size(); index++)
         {
-            auto partialLines = WrapLine(line, maxWidth);
-            std::copy(partialLines.begin(), partialLines.end(), std::back_inserter(lines));
+            if (_Informations[index].Name() == name)
+            {
+                return index;
+            }
         }
-
-        return lines;
+        throw WhispArgException("Argument \"" + name + "\" is not part of the parser.");
     }
 
-    /// @brief Wraps text to the specified width.
-    /// @note Newline characters are ignored. If @c text may contain newline characters, WrapLines is recommended
-    /// instead.
-    static std::vector<std::string> WrapLine(const std::string &text, size_t maxWidth)
+    /// @brief Drops the tokens that may change when the input changes at @c position.
+    /// @note A token that ends right at @c position may be extended, so it is dropped as well.
+    void DropTokensFrom(std::size_t position)
     {
-        std::vector<std::string> lines;
-        std::istringstream words(text);
-        std::string word;
-        std::string currentLine;
+        while (!_Tokens.empty() && _Tokens.back().End >= position)
+        {
+            auto index = _Tokens.size() - 1;
+            for (auto argument : _Tokens.back().Matched)
+            {
+                _Matches[argument].pop_back();
+            }
+            if (!_UnknownTokens.empty() && _UnknownTokens.back() == index)
+            {
+                _UnknownTokens.pop_back();
+            }
+            _Tokens.pop_back();
+        }
+    }
 
-        while (words >> word)
+    /// @brief Tokenizes and validates the input from @c position onwards.
+    void TokenizeFrom(std::size_t position)
+    {
+        _LastTokenizedCount = 0;
+        auto text = std::string();
+        while (true)
         {
-            if (currentLine.length() + word.length() + 1 <= maxWidth)
+            if (!NextToken(_Line, position, text))
             {
-                if (!currentLine.empty())
+                break;
+            }
+            _LastTokenizedCount++;
+
+            auto index = _Tokens.size();
+            auto token = TokenState{position, text, {}};
+            auto isConsumed = [&](std::size_t argument) {
+                if (index == 0 || _Informations[argument].IsFlag())
                 {
-                    currentLine += " ";
+                    return false;
                 }
-                currentLine += word;
+                const auto &previous = _Tokens.back().Matched;
+                return std::find(previous.begin(), previous.end(), argument) != previous.end();
+            };
+
+            auto key = _Keys.find(token.Text);
+            if (key != _Keys.end())
+            {
+                std::copy_if(key->second.begin(), key->second.end(), std::back_inserter(token.Matched),
+                             [&](std::size_t argument) { return !isConsumed(argument); });
             }
-            else
+            else if (token.Text.size() > 1 && token.Text[0] == '-')
             {
-                if (!currentLine.empty())
+                auto isValue = index > 0 && std::any_of(_Tokens.back().Matched.begin(), _Tokens.back().Matched.end(),
+                                                        [&](std::size_t argument) {
+                                                            return !_Informations[argument].IsFlag();
+                                                        });
+                if (!isValue)
                 {
-                    lines.push_back(currentLine);
+                    _UnknownTokens.push_back(index);
                 }
-                currentLine = word;
             }
-        }
 
-        if (!currentLine.empty())
-        {
-            lines.push_back(currentLine);
+            for (auto argument : token.Matched)
+            {
+                _Matches[argument].push_back(index);
+            }
+            _Tokens.push_back(std::move(token));
         }
-
-        return lines;
     }
 };
 
@@ -61,9 +61,11 @@ int main(int argc, char *argv[])
         auto lengthArgument = idofront::whisparg::Argument<uint8_t>::New('l', "length")
                                   .Description("The length of the manager.")
                                   .Default(1);
+        // Note: Arguments with a Section are listed under their own heading in the help message.
         auto messageArgument = idofront::whisparg::Argument<std::string>::New("message")
                                    .Description("The message to be published.")
-                                   .Default("Hello, world!");
+                                   .Default("Hello, world!")
+                                   .Section("Output");
 
         // stem 2.2: Parse arguments.
         auto helpWidth = parser.Parse(helpWidthArgument);
@@ -83,6 +85,22 @@ int main(int argc, char *argv[])
             parser.ShowHelp(helpWidth.Value().value());
             return 0;
         }
+        // Note: "--help=<topic>" shows only the arguments of a section, or the arguments matching a keyword.
+        // "--help=all" also shows the arguments marked with IsAdvanced(true).
+        auto helpTopic = parser.HelpTopic();
+        if (helpTopic.has_value())
+        {
+            parser.ShowHelp(helpWidth.Value().value(), helpTopic.value());
+            return 0;
+        }
+
+        // Note: "--whisparg-schema" prints the parsed arguments as JSON, e.g. for deployment tools and config
+        // validators.
+        if (parser.IsSchemaRequested())
+        {
+            parser.ShowSchema();
+            return 0;
+        }
 
         // step 3.2: Process the arguments you are interested in.
         if (noDescription.Value().value())
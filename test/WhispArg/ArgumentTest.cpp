@@ -3,6 +3,7 @@
 #include <optional>
 #include <sstream>
 #include <string>
+#include <vector>
 
 using namespace idofront::whisparg;
 
@@ -118,3 +119,110 @@ TEST(ArgumentTest, ToHelpStringForFlag)
     // The default value is displayed
     EXPECT_NE(std::string::npos, helpStr.find("(Default: false)"));
 }
+
+TEST(ArgumentTest, SetSectionAndAdvanced)
+{
+    // Arrange
+    auto arg = Argument<int>::New('n', "number").Section("Tuning").IsAdvanced(true);
+
+    // Act & Assert
+    EXPECT_EQ("Tuning", arg.Section());
+    EXPECT_TRUE(arg.IsAdvanced());
+    EXPECT_EQ("", Argument<int>::New("plain").Section()); // default: no section
+    EXPECT_FALSE(Argument<int>::New("plain").IsAdvanced()); // default: false
+}
+
+TEST(ArgumentTest, ViolationsListsUnsatisfiedConstraints)
+{
+    // Arrange
+    auto threads = Argument<int>::New("threads")
+                       .Min(1)
+                       .Max(256)
+                       .Constraint([](const int &value) { return value % 2 == 0; }, "must be even");
+    auto mode = Argument<std::string>::New("mode").OneOf({"fast", "safe"});
+
+    // Act & Assert
+    EXPECT_TRUE(threads.Violations(8).empty());
+    EXPECT_EQ((std::vector<std::string>{"Argument \"threads\" must be at least 1.",
+                                        "Argument \"threads\" must be even."}),
+              threads.Violations(-1));
+    EXPECT_EQ((std::vector<std::string>{"Argument \"threads\" must be at most 256."}), threads.Violations(258));
+    EXPECT_TRUE(mode.Violations("safe").empty());
+    EXPECT_EQ((std::vector<std::string>{"Argument \"mode\" must be one of fast, safe."}), mode.Violations("slow"));
+    EXPECT_EQ(",\"minimum\":1,\"maximum\":256", threads.SchemaConstraints());
+    EXPECT_EQ(",\"enum\":[\"fast\",\"safe\"]", mode.SchemaConstraints());
+}
+
+TEST(ArgumentTest, SchemaConstraintsWriteEachLimitOnce)
+{
+    // Arrange
+    auto threads = Argument<type::Bounded<int, 1, 64>>::New("threads").Min(2);
+    auto workers = Argument<type::Bounded<int, 1, 64>>::New("workers").Max(32);
+    auto ratio = Argument<int>::New("ratio").Min(0).Min(5).Max(10).Max(20);
+
+    // Act & Assert
+    EXPECT_EQ(",\"minimum\":2,\"maximum\":64", threads.SchemaConstraints());
+    EXPECT_EQ(",\"minimum\":1,\"maximum\":32", workers.SchemaConstraints());
+    EXPECT_EQ(",\"minimum\":5,\"maximum\":10", ratio.SchemaConstraints());
+}
+
+TEST(ArgumentTest, PatternRequiresTheWholeValueToMatch)
+{
+    // Arrange
+    auto tenant = Argument<std::string>::New("tenant").Pattern("[a-z0-9-]{3,63}");
+
+    // Act & Assert
+    EXPECT_TRUE(tenant.Violations("acme-01").empty());
+    EXPECT_EQ((std::vector<std::string>{"Argument \"tenant\" must match the pattern \"[a-z0-9-]{3,63}\"."}),
+              tenant.Violations("Acme"));
+    EXPECT_EQ(",\"pattern\":\"^(?:[a-z0-9-]{3,63})$\"", tenant.SchemaConstraints());
+    EXPECT_THROW(Argument<std::string>::New("id").Pattern("[a-"), WhispArgException);
+}
+
+TEST(ArgumentTest, ReferenceAccessors)
+{
+    // Arrange
+    auto arg = Argument<std::string>::New('m', "message").Description("A message.");
+    auto withDefault = Argument<std::string>::New("message").Default("hello");
+    auto updated = Argument<std::string>::Update(withDefault, "world");
+    auto fallback = std::string("fallback");
+
+    // Act & Assert
+    EXPECT_EQ("message", arg.NameView());
+    EXPECT_EQ("m", arg.ShortNameView());
+    EXPECT_EQ("A message.", arg.DescriptionView());
+    EXPECT_THROW(arg.Get(), WhispArgException);
+    EXPECT_EQ(&fallback, &arg.ValueOr(fallback));
+    EXPECT_EQ("hello", withDefault.Get());
+    EXPECT_EQ("hello", withDefault.ValueOr(fallback));
+    EXPECT_EQ("world", updated.Get());
+    EXPECT_EQ(&updated.Get(), &updated.Get()); // No copy is made
+}
+
+TEST(ArgumentTest, DefaultFromIsEvaluatedOnceWhenNeeded)
+{
+    // Arrange
+    auto calls = 0;
+    auto arg = Argument<std::string>::New("host").Description("Host.").DefaultFrom(
+        [&calls]() {
+            calls++;
+            return std::string("computed");
+        },
+        "<hostname>");
+    auto copy = arg;
+
+    // Act
+    auto help = arg.ToHelpString();
+    auto given = Argument<std::string>::Update(arg, "given").Get();
+    auto callsBeforeDefault = calls;
+    auto first = arg.Default();
+    auto second = copy.Get();
+
+    // Assert
+    EXPECT_EQ("  --host <HOST>\n    Host. (Default: <hostname>)", help);
+    EXPECT_EQ("given", given);
+    EXPECT_EQ(0, callsBeforeDefault);
+    EXPECT_EQ("computed", first.value());
+    EXPECT_EQ("computed", second);
+    EXPECT_EQ(1, calls);
+}
@@ -0,0 +1,140 @@
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <idofront/WhispArg.hpp>
+#include <string>
+#include <vector>
+
+using namespace idofront::whisparg;
+
+TEST(BatchParserTest, TokenizeSplitsOnWhitespaceAndQuotes)
+{
+    // Act
+    auto tokens = Tokenize("  --message \"hello world\" -n '4 2'  --path a\\ b ");
+
+    // Assert
+    auto expected = std::vector<std::string>{"--message", "hello world", "-n", "4 2", "--path", "a b"};
+    EXPECT_EQ(expected, tokens);
+}
+
+TEST(BatchParserTest, ParseProducesOneColumnPerArgument)
+{
+    // Arrange
+    auto number = Argument<int32_t>::New('n', "number").Default(7);
+    auto message = Argument<std::string>::New("message");
+    auto verbose = Argument<type::Flag>::New('v', "verbose");
+    auto parser = BatchParser().Add(number).Add(message).Add(verbose);
+
+    // Act
+    auto result = parser.Parse("-n 1 --message a\n--message \"b c\" -v\n\n--number 3 --number 4", 2);
+
+    // Assert
+    ASSERT_EQ(4u, result.Rows());
+    EXPECT_TRUE(result.Diagnostics().empty());
+
+    auto numbers = result.Column(number);
+    EXPECT_EQ(1, numbers[0].value());
+    EXPECT_EQ(7, numbers[1].value()); // Default value
+    EXPECT_EQ(7, numbers[2].value()); // Empty line
+    EXPECT_EQ(4, numbers[3].value()); // The last occurrence wins
+
+    auto messages = result.Column(message);
+    EXPECT_EQ("a", messages[0].value());
+    EXPECT_EQ("b c", messages[1].value());
+    EXPECT_FALSE(messages[2].has_value());
+
+    auto verboses = result.Column(verbose);
+    EXPECT_FALSE(verboses[0].value());
+    EXPECT_TRUE(verboses[1].value());
+}
+
+TEST(BatchParserTest, DiagnosticsAreReportedPerLine)
+{
+    // Arrange
+    auto number = Argument<int32_t>::New('n', "number");
+    auto name = Argument<std::string>::New("name").IsRequired(true);
+    auto parser = BatchParser().Add(number).Add(name);
+
+    // Act
+    auto result = parser.Parse("--name a -n x\n--name b\n-n 1\n--name c -n", 3);
+
+    // Assert
+    ASSERT_EQ(3u, result.Diagnostics().size());
+    EXPECT_EQ(0u, result.Diagnostics()[0].Line());
+    EXPECT_NE(std::string::npos, result.Diagnostics()[0].Message().find("Failed to parse the argument \"number\""));
+    EXPECT_EQ(2u, result.Diagnostics()[1].Line());
+    EXPECT_EQ("Argument \"name\" is required.", result.Diagnostics()[1].Message());
+    EXPECT_EQ(3u, result.Diagnostics()[2].Line());
+    EXPECT_EQ("Argument \"number\" requires a value.", result.Diagnostics()[2].Message());
+
+    EXPECT_EQ("b", result.Column(name)[1].value());
+}
+
+TEST(BatchParserTest, ConstraintViolationsLeaveNoValue)
+{
+    // Arrange
+    auto threads = Argument<int32_t>::New("threads").Max(8);
+    auto parser = BatchParser().Add(threads);
+
+    // Act
+    auto result = parser.Parse("--threads 100\n--threads 4", 1);
+
+    // Assert
+    ASSERT_EQ(1u, result.Diagnostics().size());
+    EXPECT_EQ(0u, result.Diagnostics()[0].Line());
+    EXPECT_NE(std::string::npos, result.Diagnostics()[0].Message().find("must be at most 8"));
+    EXPECT_FALSE(result.Column(threads)[0].has_value());
+    EXPECT_EQ(4, result.Column(threads)[1].value());
+}
+
+TEST(BatchParserTest, ParseMatchesParseFunctionOnEveryLine)
+{
+    // Arrange
+    auto number = Argument<int64_t>::New('n', "number").Default(-1);
+    auto parser = BatchParser().Add(number);
+    auto text = std::string();
+    for (auto i = 0; i < 1000; i++)
+    {
+        text += (i % 3 == 0 ? "-n " : "--number ") + std::to_string(i) + (i % 5 == 0 ? " -n 5" : "") + "\n";
+    }
+
+    // Act
+    auto result = parser.Parse(text, 4);
+
+    // Assert
+    ASSERT_EQ(1000u, result.Rows());
+    auto numbers = result.Column(number);
+    for (auto i = std::size_t(0); i < result.Rows(); i++)
+    {
+        auto line = text.substr(0, text.find('\n'));
+        text.erase(0, line.size() + 1);
+        EXPECT_EQ(Parse(Tokenize(line), number), numbers[i]) << line;
+    }
+}
+
+TEST(BatchParserTest, ParseFileReadsLinesFromFile)
+{
+    // Arrange
+    auto path = testing::TempDir() + "BatchParserTest.jobs";
+    std::ofstream(path) << "--number 1\n--number 2\n";
+    auto number = Argument<uint16_t>::New("number");
+
+    // Act
+    auto result = BatchParser().Add(number).ParseFile(path);
+    std::remove(path.c_str());
+
+    // Assert
+    ASSERT_EQ(2u, result.Rows());
+    EXPECT_EQ(1, result.Column(number)[0].value());
+    EXPECT_EQ(2, result.Column(number)[1].value());
+}
+
+TEST(BatchParserTest, ColumnOfUnknownArgumentThrows)
+{
+    // Arrange
+    auto result = BatchParser().Add(Argument<int32_t>::New("number")).Parse("--number 1");
+
+    // Act & Assert
+    EXPECT_THROW(result.Column(Argument<int32_t>::New("other")), WhispArgException);
+    EXPECT_THROW(result.Column(Argument<std::string>::New("number")), WhispArgException);
+}
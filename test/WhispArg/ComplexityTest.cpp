@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <idofront/WhispArg.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace idofront::whisparg;
+
+// These tests compare wall-clock times, so ctest only runs them when configured with -DWHISPARG_TIMING_TESTS=ON.
+
+namespace
+{
+/// @brief Measures the time per unit of input, taking the fastest of several runs.
+template <typename Prepare, typename Run> double NanosecondsPerUnit(std::size_t units, Prepare prepare, Run run)
+{
+    auto best = std::chrono::nanoseconds::max();
+    for (auto i = 0; i < 3; i++)
+    {
+        auto input = prepare(units);
+        auto start = std::chrono::steady_clock::now();
+        run(input);
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        best = std::min(best, elapsed);
+    }
+    return static_cast<double>(best.count()) / static_cast<double>(units);
+}
+
+/// @brief Expects the time per unit to stay roughly constant when the input grows eightfold.
+template <typename Prepare, typename Run> void ExpectLinear(std::size_t units, Prepare prepare, Run run)
+{
+    auto small = NanosecondsPerUnit(units, prepare, run);
+    auto large = NanosecondsPerUnit(units * 8, prepare, run);
+    EXPECT_LT(large, small * 4) << "Time per unit grew from " << small << "ns to " << large << "ns.";
+}
+
+std::string RepeatedOptions(std::size_t count)
+{
+    auto text = std::string();
+    for (auto i = std::size_t(0); i < count; i++)
+    {
+        text += "--number 1 ";
+    }
+    return text;
+}
+} // namespace
+
+TEST(ComplexityTest, TokenizeHugeSingleTokenIsLinear)
+{
+    ExpectLinear(
+        std::size_t(128 * 1024), [](std::size_t size) { return std::string(size, 'a'); },
+        [](const std::string &text) { EXPECT_EQ(1u, Tokenize(text).size()); });
+}
+
+TEST(ComplexityTest, TokenizeHugeQuotedTokenIsLinear)
+{
+    ExpectLinear(
+        std::size_t(64 * 1024),
+        [](std::size_t size) {
+            auto text = std::string("\"");
+            for (auto i = std::size_t(0); i < size; i++)
+            {
+                text += "\\\" ";
+            }
+            return text;
+        },
+        [](const std::string &text) { EXPECT_EQ(1u, Tokenize(text).size()); });
+}
+
+TEST(ComplexityTest, ParseRepeatedOptionsIsLinear)
+{
+    auto number = Argument<int32_t>::New('n', "number");
+    ExpectLinear(
+        std::size_t(128 * 1024),
+        [](std::size_t count) {
+            auto argv = std::vector<std::string>();
+            for (auto i = std::size_t(0); i < count; i++)
+            {
+                argv.push_back(i % 2 == 0 ? "--number" : "1");
+            }
+            return argv;
+        },
+        [&](const std::vector<std::string> &argv) { EXPECT_EQ(1, Parse(argv, number).value()); });
+}
+
+TEST(ComplexityTest, BatchParseRepeatedOptionsIsLinear)
+{
+    auto parser = BatchParser().Add(Argument<int32_t>::New('n', "number"));
+    ExpectLinear(std::size_t(16 * 1024), RepeatedOptions,
+                 [&](const std::string &text) { EXPECT_TRUE(parser.Parse(text, 1).Diagnostics().empty()); });
+}
+
+TEST(ComplexityTest, IncrementalTypingCostDoesNotDependOnLineLength)
+{
+    auto parser = IncrementalParser().Add(Argument<int32_t>::New('n', "number"));
+    auto keystrokesPerTest = 1000;
+    auto costPerKeystroke = [&](std::size_t options) {
+        parser.Update(RepeatedOptions(options));
+        auto start = std::chrono::steady_clock::now();
+        for (auto i = 0; i < keystrokesPerTest; i++)
+        {
+            parser.Append(i % 8 == 7 ? " " : "x");
+        }
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    auto shortLine = std::min({costPerKeystroke(100), costPerKeystroke(100), costPerKeystroke(100)});
+    auto longLine = std::min({costPerKeystroke(100000), costPerKeystroke(100000), costPerKeystroke(100000)});
+    EXPECT_LT(longLine, shortLine * 4);
+}
+
+TEST(ComplexityTest, HelpWrappingIsLinear)
+{
+    ExpectLinear(
+        std::size_t(16 * 1024),
+        [](std::size_t words) {
+            auto description = std::string();
+            for (auto i = std::size_t(0); i < words; i++)
+            {
+                description += i % 64 == 0 ? std::string(200, 'w') + " " : "word ";
+            }
+            return description;
+        },
+        [](const std::string &description) {
+            char program[] = "complexity";
+            char *argv[] = {program, nullptr};
+            auto parser = WhispArg(1, argv).Description(description);
+            parser.Parse(Argument<std::string>::New("option").Description(description));
+
+            auto output = std::ostringstream();
+            auto original = std::cout.rdbuf(output.rdbuf());
+            parser.ShowHelp(80);
+            std::cout.rdbuf(original);
+            EXPECT_FALSE(output.str().empty());
+        });
+}
@@ -0,0 +1,312 @@
+#include "LegacyParse.hpp"
+#include <gtest/gtest.h>
+#include <idofront/WhispArg.hpp>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace idofront::whisparg;
+
+namespace
+{
+/// @brief The result of parsing one argument: an error, or a value that may be absent.
+struct Outcome
+{
+    bool IsError;
+    std::optional<std::string> Value;
+
+    bool operator==(const Outcome &other) const
+    {
+        return IsError == other.IsError && Value == other.Value;
+    }
+};
+
+std::ostream &operator<<(std::ostream &os, const Outcome &outcome)
+{
+    if (outcome.IsError)
+    {
+        return os << "error";
+    }
+    return os << (outcome.Value.has_value() ? "\"" + outcome.Value.value() + "\"" : "nullopt");
+}
+
+template <typename T> Outcome ToOutcome(const std::optional<T> &value)
+{
+    if (!value.has_value())
+    {
+        return Outcome{false, std::nullopt};
+    }
+    if constexpr (std::is_same_v<T, type::Flag>)
+    {
+        return Outcome{false, value.value().ToString()};
+    }
+    else
+    {
+        return Outcome{false, ToDisplayString(value.value())};
+    }
+}
+
+template <typename T, typename Run> Outcome Capture(Run run)
+{
+    try
+    {
+        return ToOutcome<T>(run());
+    }
+    catch (const WhispArgException &)
+    {
+        return Outcome{true, std::nullopt};
+    }
+}
+
+/// @brief The converters of the legacy automatic conversion, for the types the generator uses.
+template <typename T> std::function<T(const std::string &)> LegacyConverter(const Argument<T> &argument)
+{
+    if constexpr (std::is_same_v<T, std::string>)
+    {
+        return [](const std::string &value) { return value; };
+    }
+    else if constexpr (std::is_same_v<T, int32_t>)
+    {
+        return [](const std::string &value) { return static_cast<int32_t>(std::stoll(value)); };
+    }
+    else
+    {
+        return [&argument](const std::string &) { return !argument.Value().value(); };
+    }
+}
+
+/// @brief A randomly generated argument definition.
+struct Definition
+{
+    enum class Kind
+    {
+        String,
+        Integer,
+        Flag,
+    };
+    Kind Type;
+    std::string Name;
+    char ShortName;
+    bool HasDefault;
+    bool IsRequired;
+};
+
+template <typename T> Argument<T> MakeArgument(const Definition &definition)
+{
+    auto argument = definition.ShortName == '\0' ? Argument<T>::New(definition.Name)
+                                                 : Argument<T>::New(definition.ShortName, definition.Name);
+    if (definition.HasDefault)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+        {
+            argument.Default("fallback");
+        }
+        else if constexpr (std::is_same_v<T, int32_t>)
+        {
+            argument.Default(5);
+        }
+        else
+        {
+            argument.Default(type::Flag::True);
+        }
+    }
+    if (definition.IsRequired)
+    {
+        argument.IsRequired(true);
+    }
+    return argument;
+}
+
+template <typename Argument> struct ValueType;
+
+template <typename T> struct ValueType<Argument<T>>
+{
+    using Type = T;
+};
+
+/// @brief Calls @c visit with the Argument<T> of a definition.
+template <typename Visit> void VisitArgument(const Definition &definition, Visit visit)
+{
+    switch (definition.Type)
+    {
+    case Definition::Kind::String:
+        visit(MakeArgument<std::string>(definition));
+        break;
+    case Definition::Kind::Integer:
+        visit(MakeArgument<int32_t>(definition));
+        break;
+    case Definition::Kind::Flag:
+        visit(MakeArgument<type::Flag>(definition));
+        break;
+    }
+}
+
+/// @brief Generates command lines and argument definitions from small pools, so that names collide often.
+class Generator
+{
+  public:
+    explicit Generator(uint32_t seed) : _Random(seed)
+    {
+    }
+
+    std::vector<Definition> Definitions()
+    {
+        auto names = std::vector<std::string>{"alpha", "beta", "gamma", "ab", "bb"};
+        std::shuffle(names.begin(), names.end(), _Random);
+        auto definitions = std::vector<Definition>(Pick(1, 4));
+        for (auto i = std::size_t(0); i < definitions.size(); i++)
+        {
+            auto &definition = definitions[i];
+            definition.Type = static_cast<Definition::Kind>(Pick(0, 2));
+            definition.Name = names[i];
+            definition.ShortName = std::string("\0abg", 4)[Pick(0, 3)];
+            definition.HasDefault = Pick(0, 2) == 0;
+            definition.IsRequired = definition.Type != Definition::Kind::Flag && Pick(0, 4) == 0;
+        }
+        return definitions;
+    }
+
+    std::vector<std::string> Argv()
+    {
+        static const auto tokens =
+            std::vector<std::string>{"--alpha", "--beta", "--gamma", "--ab", "--bb", "-a", "-b", "-g", "-x", "--",
+                                     "-",       "",       "x",       "y z",  "42",   "-7", "abc", "--unknown"};
+        auto argv = std::vector<std::string>{"tool"};
+        for (auto count = Pick(0, 8); count > 0; count--)
+        {
+            argv.push_back(tokens[Pick(0, static_cast<int>(tokens.size()) - 1)]);
+        }
+        return argv;
+    }
+
+  private:
+    std::mt19937 _Random;
+
+    int Pick(int min, int max)
+    {
+        return std::uniform_int_distribution<int>(min, max)(_Random);
+    }
+};
+
+/// @brief Joins tokens into a line that Tokenize() splits back into the same tokens.
+/// @note The program name is kept, so that every engine sees the same tokens.
+std::string ToLine(const std::vector<std::string> &argv)
+{
+    auto line = std::string();
+    for (const auto &token : argv)
+    {
+        line += (line.empty() ? "'" : " '") + token + "'";
+    }
+    return line;
+}
+
+/// @brief Checks whether diagnostics report an error for the argument @c name.
+template <typename Messages> bool HasError(const Messages &messages, const std::string &name)
+{
+    return std::any_of(messages.begin(), messages.end(), [&](const std::string &message) {
+        return message.rfind("Unknown argument", 0) != 0 && message.find("\"" + name + "\"") != std::string::npos;
+    });
+}
+
+std::string Describe(const std::vector<std::string> &argv, const std::vector<Definition> &definitions,
+                     const Definition &definition)
+{
+    auto stream = std::ostringstream();
+    stream << "argv:";
+    for (const auto &token : argv)
+    {
+        stream << " [" << token << "]";
+    }
+    stream << "\ndefinitions:";
+    for (const auto &entry : definitions)
+    {
+        stream << " " << entry.Name << "/" << (entry.ShortName == '\0' ? '_' : entry.ShortName) << "/"
+               << static_cast<int>(entry.Type) << (entry.HasDefault ? "/default" : "")
+               << (entry.IsRequired ? "/required" : "");
+    }
+    stream << "\nargument: " << definition.Name;
+    return stream.str();
+}
+} // namespace
+
+TEST(DifferentialTest, LegacyOracleMatchesKnownCases)
+{
+    // Arrange
+    auto name = Argument<std::string>::New('n', "name");
+
+    // Act & Assert
+    EXPECT_EQ("b", legacy::Parse({"tool", "--name", "a", "-n", "b"}, name, LegacyConverter(name)).value());
+    EXPECT_EQ("--name", legacy::Parse({"tool", "--name", "--name"}, name, LegacyConverter(name)).value());
+    EXPECT_THROW(legacy::Parse({"tool", "--name"}, name, LegacyConverter(name)), WhispArgException);
+}
+
+TEST(DifferentialTest, EveryEngineAgreesWithTheLegacyParse)
+{
+    auto generator = Generator(20251018);
+    for (auto iteration = 0; iteration < 3000; iteration++)
+    {
+        // Arrange
+        auto definitions = generator.Definitions();
+        auto argv = generator.Argv();
+        auto line = ToLine(argv);
+
+        auto pointers = std::vector<char *>();
+        for (auto &token : argv)
+        {
+            pointers.push_back(token.data());
+        }
+        pointers.push_back(nullptr);
+        auto parser = WhispArg(static_cast<int>(argv.size()), pointers.data());
+
+        auto batch = BatchParser();
+        auto incremental = IncrementalParser();
+        for (const auto &definition : definitions)
+        {
+            VisitArgument(definition, [&](const auto &argument) {
+                batch = batch.Add(argument);
+                incremental = incremental.Add(argument);
+            });
+        }
+        auto batchResult = batch.Parse(line, 1);
+        auto batchMessages = std::vector<std::string>();
+        for (const auto &diagnostic : batchResult.Diagnostics())
+        {
+            batchMessages.push_back(diagnostic.Message());
+        }
+        incremental.Update(line);
+
+        for (const auto &definition : definitions)
+        {
+            VisitArgument(definition, [&](const auto &argument) {
+                using T = typename ValueType<std::decay_t<decltype(argument)>>::Type;
+
+                // Act
+                auto expected =
+                    Capture<T>([&]() { return legacy::Parse(argv, argument, LegacyConverter(argument)); });
+                auto function = Capture<T>([&]() { return Parse(argv, argument); });
+                auto indexed = Capture<T>([&]() { return parser.Parse(argument).Value(); });
+                auto batched = HasError(batchMessages, definition.Name)
+                                   ? Outcome{true, std::nullopt}
+                                   : ToOutcome<T>(batchResult.Column(argument).front());
+                auto incrementalValue = Capture<T>([&]() { return incremental.Value(argument); });
+                if (HasError(incremental.Diagnostics(), definition.Name))
+                {
+                    incrementalValue = Outcome{true, std::nullopt};
+                }
+
+                // Assert
+                auto context = Describe(argv, definitions, definition);
+                EXPECT_EQ(expected, function) << "Parse()\n" << context;
+                EXPECT_EQ(expected, indexed) << "WhispArg::Parse()\n" << context;
+                EXPECT_EQ(expected, batched) << "BatchParser\n" << context;
+                EXPECT_EQ(expected, incrementalValue) << "IncrementalParser\n" << context;
+            });
+        }
+        if (HasFailure())
+        {
+            break;
+        }
+    }
+}
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <idofront/WhispArg.hpp>
+#include <string>
+#include <vector>
+
+using namespace idofront::whisparg;
+
+namespace
+{
+/// @brief Creates a directory tree for the tests and removes it afterwards.
+class GlobTest : public ::testing::Test
+{
+  protected:
+    std::string Root;
+
+    void SetUp() override
+    {
+        Root = (std::filesystem::temp_directory_path() /
+                ("WhispArgGlobTest-" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "-" +
+                 ::testing::UnitTest::GetInstance()->current_test_info()->name()))
+                   .string();
+        std::filesystem::remove_all(Root);
+        for (const auto &path : {"2026-01/part-0.csv", "2026-01/part-1.csv", "2026-01/.hidden.csv",
+                                 "2026-02/part-0.csv", "2026-02/part-a.csv", "2026-02/notes.txt", "2025-12/part-0.csv",
+                                 "other/part-0.csv"})
+        {
+            auto file = std::filesystem::path(Root) / path;
+            std::filesystem::create_directories(file.parent_path());
+            std::ofstream(file) << path;
+        }
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(Root);
+    }
+};
+} // namespace
+
+TEST_F(GlobTest, ExpandMatchesWildcardsInEverySegment)
+{
+    // Arrange
+    auto glob = type::Glob::Parse(Root + "/2026-*/part-?.csv");
+
+    // Act
+    auto matches = glob.Expand(1);
+
+    // Assert
+    auto expected = std::vector<std::string>{Root + "/2026-01/part-0.csv", Root + "/2026-01/part-1.csv",
+                                             Root + "/2026-02/part-0.csv", Root + "/2026-02/part-a.csv"};
+    EXPECT_EQ(expected, matches);
+}
+
+TEST_F(GlobTest, ExpandMatchesCharacterClasses)
+{
+    // Act & Assert
+    EXPECT_EQ(std::vector<std::string>({Root + "/2026-01/part-0.csv", Root + "/2026-01/part-1.csv",
+                                        Root + "/2026-02/part-0.csv"}),
+              type::Glob::Parse(Root + "/202[6-9]-*/part-[0-9].csv").Expand(1));
+    EXPECT_EQ(std::vector<std::string>({Root + "/2026-02/part-a.csv"}),
+              type::Glob::Parse(Root + "/*/part-[!0-9].csv").Expand(1));
+}
+
+TEST_F(GlobTest, WildcardsDoNotMatchHiddenFiles)
+{
+    // Act & Assert
+    EXPECT_EQ(std::vector<std::string>({Root + "/2026-01/part-0.csv", Root + "/2026-01/part-1.csv"}),
+              type::Glob::Parse(Root + "/2026-01/*.csv").Expand(1));
+    EXPECT_EQ(std::vector<std::string>({Root + "/2026-01/.hidden.csv"}),
+              type::Glob::Parse(Root + "/2026-01/.*.csv").Expand(1));
+}
+
+TEST_F(GlobTest, ParallelExpansionFindsTheSameMatches)
+{
+    // Arrange
+    for (auto i = 0; i < 64; i++)
+    {
+        auto directory = std::filesystem::path(Root) / "tree" / std::to_string(i % 8) / std::to_string(i);
+        std::filesystem::create_directories(directory);
+        std::ofstream(directory / "data.bin") << i;
+    }
+    auto glob = type::Glob::Parse(Root + "/tree/*/*/*.bin");
+
+    // Act
+    auto sequential = glob.Expand(1);
+    auto parallel = glob.Expand(4);
+    auto streamed = std::vector<std::string>();
+    auto options = type::Glob::Options();
+    options.Threads = 4;
+    glob.Expand([&](const std::string &path) { streamed.push_back(path); }, options);
+
+    // Assert
+    EXPECT_EQ(64u, sequential.size());
+    EXPECT_EQ(sequential, parallel);
+    std::sort(streamed.begin(), streamed.end());
+    EXPECT_EQ(sequential, streamed);
+}
+
+TEST_F(GlobTest, ExpandChecksLiteralPatternsAndMissingDirectories)
+{
+    // Act & Assert
+    EXPECT_EQ(std::vector<std::string>({Root + "/other/part-0.csv"}),
+              type::Glob::Parse(Root + "/other/part-0.csv").Expand(1));
+    EXPECT_TRUE(type::Glob::Parse(Root + "/other/part-9.csv").Expand(1).empty());
+    EXPECT_TRUE(type::Glob::Parse(Root + "/missing/*.csv").Expand(2).empty());
+}
+
+TEST_F(GlobTest, ExpandRethrowsCallbackExceptions)
+{
+    // Arrange
+    auto glob = type::Glob::Parse(Root + "/*/*.csv");
+    auto options = type::Glob::Options();
+    options.Threads = 2;
+
+    // Act & Assert
+    EXPECT_THROW(glob.Expand([](const std::string &) { throw std::runtime_error("stop"); }, options),
+                 std::runtime_error);
+}
+
+TEST(GlobPatternTest, MatchesDoesNotAccessTheFileSystem)
+{
+    // Arrange
+    auto glob = type::Glob::Parse("logs/*/app-[0-9][0-9].log");
+
+    // Act & Assert
+    EXPECT_TRUE(glob.Matches("logs/web/app-01.log"));
+    EXPECT_FALSE(glob.Matches("logs/web/app-1.log"));
+    EXPECT_FALSE(glob.Matches("logs/web/extra/app-01.log"));
+    EXPECT_FALSE(glob.Matches("logs/.cache/app-01.log"));
+    EXPECT_TRUE(type::Glob::Parse("a\\*b").Matches("a*b"));
+    EXPECT_FALSE(type::Glob::Parse("a\\*b").Matches("axb"));
+    EXPECT_TRUE(type::Glob::Parse("[a").Matches("[a"));
+}
+
+TEST(GlobPatternTest, ArgumentParsesGlob)
+{
+    // Arrange
+    char program[] = "program";
+    char option[] = "--input";
+    char value[] = "data/*.csv";
+    char *argv[] = {program, option, value, nullptr};
+    auto parser = WhispArg(3, argv);
+
+    // Act
+    auto input = parser.Parse(Argument<type::Glob>::New("input"));
+
+    // Assert
+    EXPECT_EQ("data/*.csv", input.Get().Pattern());
+    EXPECT_THROW(type::Glob::Parse(""), WhispArgException);
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <idofront/WhispArg.hpp>
+#include <string>
+#include <vector>
+
+using namespace idofront::whisparg;
+
+TEST(IncrementalParserTest, TypingOnlyTokenizesTheLastToken)
+{
+    // Arrange
+    auto number = Argument<int32_t>::New('n', "number");
+    auto parser = IncrementalParser().Add(number);
+    auto line = std::string();
+    for (auto i = 0; i < 100; i++)
+    {
+        line += "--number " + std::to_string(i) + " ";
+    }
+    parser.Update(line);
+
+    // Act
+    parser.Update(line + "-");
+    parser.Update(line + "-n");
+    parser.Append(" 4");
+    parser.Append("2");
+
+    // Assert
+    EXPECT_EQ(1u, parser.LastTokenizedCount());
+    EXPECT_EQ(202u, parser.Tokens().size());
+    EXPECT_EQ(42, parser.Value(number).value());
+    EXPECT_TRUE(parser.Diagnostics().empty());
+}
+
+TEST(IncrementalParserTest, EditingInTheMiddleRetokenizesTheSuffix)
+{
+    // Arrange
+    auto number = Argument<int32_t>::New('n', "number");
+    auto parser = IncrementalParser().Add(number);
+    parser.Update("--number 1 --number 2");
+
+    // Act
+    parser.Update("--number 1 --numbe 2");
+
+    // Assert
+    EXPECT_EQ(2u, parser.LastTokenizedCount());
+    EXPECT_EQ(1, parser.Value(number).value());
+    ASSERT_EQ(1u, parser.Diagnostics().size());
+    EXPECT_EQ("Unknown argument \"--numbe\".", parser.Diagnostics()[0]);
+}
+
+TEST(IncrementalParserTest, DiagnosticsReportMissingValuesAndRequiredArguments)
+{
+    // Arrange
+    auto number = Argument<int32_t>::New('n', "number");
+    auto name = Argument<std::string>::New("name").IsRequired(true);
+    auto parser = IncrementalParser().Add(number).Add(name);
+
+    // Act
+    parser.Update("-n");
+
+    // Assert
+    auto expected =
+        std::vector<std::string>{"Argument \"number\" requires a value.", "Argument \"name\" is required."};
+    EXPECT_EQ(expected, parser.Diagnostics());
+
+    // Act
+    parser.Update("-n --name x");
+
+    // Assert
+    // "--name" is the value of "-n", and also matches "--name" as Parse() does.
+    EXPECT_TRUE(parser.Diagnostics().empty());
+    EXPECT_EQ("x", parser.Value(name).value());
+    EXPECT_THROW(parser.Value(number), WhispArgException);
+}
+
+TEST(IncrementalParserTest, ValueThrowsForAnEmptyRequiredArgument)
+{
+    // Arrange
+    auto name = Argument<std::string>::New("name").IsRequired(true).Default("fallback");
+    auto parser = IncrementalParser().Add(name);
+
+    // Act
+    parser.Update("--name ''");
+
+    // Assert
+    EXPECT_THROW(parser.Value(name), WhispArgException); // as Parse() does
+    EXPECT_THROW(Parse({"tool", "--name", ""}, name), WhispArgException);
+}
+
+TEST(IncrementalParserTest, CandidatesCompleteTheLastToken)
+{
+    // Arrange
+    auto parser = IncrementalParser()
+                      .Add(Argument<int32_t>::New("number"))
+                      .Add(Argument<std::string>::New("name"))
+                      .Add(Argument<type::Flag>::New("verbose"));
+
+    // Act
+    parser.Update("--verbose --n");
+
+    // Assert
+    auto expected = std::vector<std::string>{"--number", "--name"};
+    EXPECT_EQ(expected, parser.Candidates());
+
+    // Act
+    parser.Update("--verbose --n ");
+
+    // Assert
+    EXPECT_TRUE(parser.Candidates().empty());
+}
+
+TEST(IncrementalParserTest, ValueMatchesParseFunction)
+{
+    // Arrange
+    auto flag = Argument<type::Flag>::New('f', "flag");
+    auto text = Argument<std::string>::New('t', "text").Default("none");
+    auto parser = IncrementalParser().Add(flag).Add(text);
+    auto line = std::string("-t -t -t -f -t 'a b' -f");
+
+    // Act
+    for (auto i = std::size_t(0); i <= line.size(); i++)
+    {
+        parser.Update(line.substr(0, i));
+        auto tokens = Tokenize(line.substr(0, i));
+
+        // Assert
+        EXPECT_EQ(Parse(tokens, flag), parser.Value(flag)) << line.substr(0, i);
+        if (tokens.empty() || tokens.back() != "-t")
+        {
+            EXPECT_EQ(Parse(tokens, text), parser.Value(text)) << line.substr(0, i);
+        }
+    }
+}
@@ -0,0 +1,72 @@
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <idofront/WhispArg.hpp>
+#include <string>
+#include <vector>
+
+using namespace idofront::whisparg;
+
+TEST(JsonSourceTest, FindReadsScalarsByDottedPath)
+{
+    // Arrange
+    auto source = JsonSource::FromString(R"({
+        "name": "server",
+        "skipped": {"nested": [1, {"name": "wrong"}, "]}\"{"], "more": {}},
+        "server": {"port": 8080, "tls": {"enabled": true, "cert": "a\"b\\cé😀"}},
+        "ratio": -1.5e3,
+        "empty": null,
+        "list": [1, 2]
+    })");
+
+    // Act & Assert
+    EXPECT_EQ("server", source->Find("name").value());
+    EXPECT_EQ("8080", source->Find("server.port").value());
+    EXPECT_EQ("true", source->Find("server.tls.enabled").value());
+    EXPECT_EQ("a\"b\\c\xc3\xa9\xf0\x9f\x98\x80", source->Find("server.tls.cert").value());
+    EXPECT_EQ("-1.5e3", source->Find("ratio").value());
+    EXPECT_EQ("[1, 2]", source->Find("list").value());
+    EXPECT_FALSE(source->Find("empty").has_value());
+    EXPECT_FALSE(source->Find("missing").has_value());
+    EXPECT_FALSE(source->Find("server.port.value").has_value());
+    EXPECT_FALSE(source->Find("skipped.more.name").has_value());
+}
+
+TEST(JsonSourceTest, FindThrowsOnMalformedDocument)
+{
+    // Arrange
+    auto unterminated = JsonSource::FromString(R"({"a": {"b": "c)");
+    auto missingColon = JsonSource::FromString(R"({"a" 1})");
+
+    // Act & Assert
+    EXPECT_THROW(unterminated->Find("z"), WhispArgException);
+    EXPECT_THROW(missingColon->Find("a"), WhispArgException);
+}
+
+TEST(JsonSourceTest, ConfigValuesOverrideProfilesButNotTheCommandLine)
+{
+    // Arrange
+    auto path = std::string(testing::TempDir()) + "JsonSourceTest.json";
+    std::ofstream(path) << R"({"threads": 8, "log": {"level": "debug", "color": true}, "batch-size": 32})";
+
+    static constexpr ProfileEntry Batch[] = {{"batch-size", "1024"}, {"timeout", "60"}};
+    std::string arguments[] = {"tool", "--profile", "batch", "--threads", "2"};
+    char *argv[] = {arguments[0].data(), arguments[1].data(), arguments[2].data(), arguments[3].data(),
+                    arguments[4].data(), nullptr};
+    auto parser = WhispArg(5, argv).AddProfile(Profile("batch", Batch)).Config(path);
+
+    // Act
+    auto threads = parser.Parse(Argument<int32_t>::New("threads").Default(1));
+    auto level = parser.Parse(Argument<std::string>::New("log-level").ConfigKey("log.level"));
+    auto color = parser.Parse(Argument<type::Flag>::New("color").ConfigKey("log.color"));
+    auto batchSize = parser.Parse(Argument<int32_t>::New("batch-size").Default(16));
+    auto timeout = parser.Parse(Argument<int32_t>::New("timeout").Default(30));
+    std::remove(path.c_str());
+
+    // Assert
+    EXPECT_EQ(2, threads.Value().value());     // The command line wins
+    EXPECT_EQ("debug", level.Value().value()); // Nested key
+    EXPECT_TRUE(color.Value().value());        // A flag in a config gives the value itself
+    EXPECT_EQ(32, batchSize.Value().value());  // The config overrides the profile
+    EXPECT_EQ(60, timeout.Value().value());    // Not in the config
+}
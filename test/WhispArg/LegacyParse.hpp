@@ -0,0 +1,97 @@
+#pragma once
+
+#include <functional>
+#include <idofront/WhispArg.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+// The linear-scan Parse() as it was before the indexed and incremental engines were added. It is kept unchanged as
+// the reference that DifferentialTest compares those engines against, so do not optimize it.
+namespace legacy
+{
+using idofront::whisparg::Argument;
+using idofront::whisparg::WhispArgException;
+namespace type = idofront::whisparg::type;
+
+/// @brief Parses command-line arguments.
+/// @tparam T The type of the command-line argument.
+/// @param argv A vector of command-line arguments.
+/// @param argument The definition of the command-line argument.
+/// @param converter A function that converts the command-line argument string into type T.
+/// @return The value of the command-line argument (wrapped in std::optional).
+template <typename T>
+std::optional<T> Parse(std::vector<std::string> argv, const Argument<T> &argument,
+                       std::function<T(const std::string &)> converter)
+{
+    std::size_t argc = argv.size();
+
+    auto argumentName = argument.Name();
+    auto actualValue = std::string();
+
+    auto isArgumentMatched = [](const Argument<T> &argument, const std::string &currentArgumentName) {
+        switch (currentArgumentName.size())
+        {
+        case 0:
+        case 1:
+            return false;
+        case 2:
+            if (argument.ShortName().empty())
+            {
+                return false;
+            }
+            return ("-" + argument.ShortName()) == currentArgumentName;
+        default:
+            return ("--" + argument.Name()) == currentArgumentName;
+        }
+    };
+
+    for (auto i = std::size_t(0); i < argc; i++)
+    {
+        if (argv[i][0] == '-')
+        {
+            auto currentArgumentName = std::string(argv[i]);
+            if (isArgumentMatched(argument, currentArgumentName))
+            {
+                if (std::is_same_v<T, type::Flag>)
+                {
+                    actualValue = type::Flag::True.ToString();
+                }
+                else
+                {
+                    auto nextValueExists = (i + 1) < argc;
+                    if (nextValueExists)
+                    {
+                        actualValue = std::string(nextValueExists ? argv[++i] : "");
+                        continue;
+                    }
+                    else
+                    {
+                        throw WhispArgException("Argument \"" + argumentName + "\" requires a value.");
+                    }
+                }
+            }
+        }
+    }
+
+    if (actualValue.empty())
+    {
+        if (argument.IsRequired())
+        {
+            throw WhispArgException("Argument \"" + argumentName + "\" is required.");
+        }
+
+        return argument.Default();
+    }
+
+    try
+    {
+        return converter(actualValue);
+    }
+    catch (const std::exception &e)
+    {
+        throw WhispArgException("Failed to parse the argument \"" + argumentName + "\": " + e.what());
+    }
+}
+
+} // namespace legacy
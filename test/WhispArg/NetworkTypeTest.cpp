@@ -0,0 +1,126 @@
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <idofront/WhispArg.hpp>
+#include <string>
+#include <vector>
+
+using namespace idofront::whisparg;
+
+TEST(NetworkTypeTest, IpAddressParsesIpv4AndIpv6)
+{
+    // Act & Assert
+    EXPECT_EQ("10.0.0.1", type::IpAddress::Parse("10.0.0.1").ToString());
+    EXPECT_FALSE(type::IpAddress::Parse("255.255.255.255").IsV6());
+    EXPECT_EQ("2001:db8::1", type::IpAddress::Parse("2001:0DB8:0:0:0:0:0:1").ToString());
+    EXPECT_EQ("::", type::IpAddress::Parse("::").ToString());
+    EXPECT_EQ("::1", type::IpAddress::Parse("::1").ToString());
+    EXPECT_EQ("fe80::", type::IpAddress::Parse("fe80::").ToString());
+    EXPECT_EQ("1:0:1::1", type::IpAddress::Parse("1:0:1:0:0:0:0:1").ToString());
+    EXPECT_EQ("::ffff:c000:201", type::IpAddress::Parse("::ffff:192.0.2.1").ToString());
+    EXPECT_TRUE(type::IpAddress::Parse("::1").IsV6());
+}
+
+TEST(NetworkTypeTest, IpAddressMatchesInetPton)
+{
+    // Arrange
+    auto texts = std::vector<std::string>{"0.0.0.0", "1.2.3.4", "::", "1::", "::2", "1:2:3:4:5:6:7:8",
+                                          "1:2:3:4:5:6:1.2.3.4", "a::b:c", "ffff::ffff:ffff"};
+
+    for (const auto &text : texts)
+    {
+        // Act
+        auto address = type::IpAddress::Parse(text);
+        unsigned char expected[16] = {};
+        ASSERT_EQ(1, inet_pton(address.IsV6() ? AF_INET6 : AF_INET, text.c_str(), expected)) << text;
+
+        // Assert
+        EXPECT_EQ(0, std::memcmp(expected, address.Bytes().data(), address.Size())) << text;
+    }
+}
+
+TEST(NetworkTypeTest, IpAddressRejectsInvalidText)
+{
+    // Arrange
+    auto texts = std::vector<std::string>{"",       "1.2.3",   "1.2.3.4.5",  "256.0.0.1", "01.2.3.4",  "1.2.3.",
+                                          "a.b.c.d", ":::",     "1::2::3",    "1:2:3:4:5:6:7:8:9", "12345::", ":1",
+                                          "1:",     "1:2:3:4:5:6:7:1.2.3.4", "::1.2.3", "g::"};
+
+    for (const auto &text : texts)
+    {
+        // Act & Assert
+        EXPECT_THROW(type::IpAddress::Parse(text), WhispArgException) << text;
+    }
+}
+
+TEST(NetworkTypeTest, EndpointParsesHostAndPort)
+{
+    // Act
+    auto any = type::Endpoint::Parse("0.0.0.0:8080");
+    auto loopback = type::Endpoint::Parse("[::1]:443");
+    auto named = type::Endpoint::Parse("example.com:80");
+
+    // Assert
+    EXPECT_EQ("0.0.0.0", any.Host());
+    EXPECT_EQ(8080, any.Port());
+    EXPECT_TRUE(any.IsAddress());
+    EXPECT_EQ("[::1]:443", loopback.ToString());
+    EXPECT_TRUE(loopback.Address().value().IsV6());
+    EXPECT_EQ("example.com", named.Host());
+    EXPECT_FALSE(named.Address().has_value());
+
+    sockaddr_storage storage;
+    EXPECT_EQ(sizeof(sockaddr_in6), loopback.ToSockaddr(storage));
+    EXPECT_EQ(AF_INET6, storage.ss_family);
+    EXPECT_EQ(htons(443), reinterpret_cast<sockaddr_in6 &>(storage).sin6_port);
+    EXPECT_THROW(named.ToSockaddr(storage), WhispArgException);
+
+    for (auto text : {"host", "host:", "host:65536", "::1:80", "[::1]", "[1.2.3.4]:80", ":80", "a b:80"})
+    {
+        EXPECT_THROW(type::Endpoint::Parse(text), WhispArgException) << text;
+    }
+}
+
+TEST(NetworkTypeTest, CidrContainsAddressesInItsRange)
+{
+    // Act
+    auto private10 = type::Cidr::Parse("10.0.0.0/8");
+    auto documentation = type::Cidr::Parse("2001:db8::/32");
+    auto single = type::Cidr::Parse("192.0.2.1");
+
+    // Assert
+    EXPECT_TRUE(private10.Contains(type::IpAddress::Parse("10.255.0.1")));
+    EXPECT_FALSE(private10.Contains(type::IpAddress::Parse("11.0.0.1")));
+    EXPECT_FALSE(private10.Contains(type::IpAddress::Parse("::a00:1")));
+    EXPECT_TRUE(documentation.Contains(type::IpAddress::Parse("2001:db8:1::1")));
+    EXPECT_EQ("192.0.2.1/32", single.ToString());
+    EXPECT_TRUE(type::Cidr::Parse("0.0.0.0/0").Contains(type::IpAddress::Parse("1.2.3.4")));
+
+    for (auto text : {"10.0.0.1/8", "10.0.0.0/33", "10.0.0.0/", "10.0.0.0/x", "::/129", "host/8"})
+    {
+        EXPECT_THROW(type::Cidr::Parse(text), WhispArgException) << text;
+    }
+}
+
+TEST(NetworkTypeTest, ParseConvertsNetworkTypesAndLists)
+{
+    // Arrange
+    std::string arguments[] = {"tool", "--listen", "0.0.0.0:8080", "--peers", "a:1,[::1]:2", "--allow", "10.0.0.0/8",
+                               "--bad", "a:1,,b:2"};
+    char *argv[] = {arguments[0].data(), arguments[1].data(), arguments[2].data(), arguments[3].data(),
+                    arguments[4].data(), arguments[5].data(), arguments[6].data(), arguments[7].data(),
+                    arguments[8].data(), nullptr};
+    auto parser = WhispArg(9, argv);
+
+    // Act
+    auto listen = parser.Parse(Argument<type::Endpoint>::New("listen"));
+    auto peers = parser.Parse(Argument<type::List<type::Endpoint>>::New("peers"));
+    auto allow = parser.Parse(Argument<type::List<type::Cidr>>::New("allow"));
+    auto ports = Parse({"tool", "--ports", "1,2,3"}, Argument<type::List<uint16_t>>::New("ports"));
+
+    // Assert
+    EXPECT_EQ(8080, listen.Value().value().Port());
+    EXPECT_EQ("a:1,[::1]:2", (std::ostringstream() << peers.Value().value()).str());
+    EXPECT_EQ(1u, allow.Value().value().size());
+    EXPECT_EQ((type::List<uint16_t>{1, 2, 3}), ports.value());
+    EXPECT_THROW(parser.Parse(Argument<type::List<type::Endpoint>>::New("bad")), WhispArgException);
+}
@@ -0,0 +1,228 @@
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <idofront/WhispArg.hpp>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace idofront::whisparg;
+
+namespace
+{
+/// @brief Creates a directory for the tests and removes it afterwards.
+class OutputFileTest : public ::testing::Test
+{
+  protected:
+    std::string Directory;
+
+    void SetUp() override
+    {
+        Directory = (std::filesystem::temp_directory_path() /
+                     ("WhispArgOutputFileTest-" + std::to_string(::getpid()) + "-" +
+                      ::testing::UnitTest::GetInstance()->current_test_info()->name()))
+                        .string();
+        std::filesystem::remove_all(Directory);
+        std::filesystem::create_directories(Directory);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(Directory);
+    }
+
+    std::string ReadFile(const std::string &path)
+    {
+        auto stream = std::ifstream(path);
+        return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    /// @brief Parses "--output <path>" with the given options.
+    Argument<type::OutputFile> ParseOutput(WhispArg &parser, const type::OutputFile::Options &options)
+    {
+        return parser.Parse(Argument<type::OutputFile>::New("output").OutputOptions(options));
+    }
+};
+
+WhispArg NewParser(std::vector<std::string> &arguments)
+{
+    static auto argv = std::vector<char *>();
+    argv.clear();
+    for (auto &argument : arguments)
+    {
+        argv.push_back(argument.data());
+    }
+    argv.push_back(nullptr);
+    return WhispArg(static_cast<int>(arguments.size()), argv.data());
+}
+} // namespace
+
+TEST_F(OutputFileTest, ParseOpensTheFileForWriting)
+{
+    // Arrange
+    auto path = Directory + "/result.bin";
+    auto arguments = std::vector<std::string>{"tool", "--output", path};
+    auto parser = NewParser(arguments);
+
+    // Act
+    auto output = ParseOutput(parser, type::OutputFile::Options());
+
+    // Assert
+    EXPECT_TRUE(parser.Violations().empty());
+    ASSERT_TRUE(output.Get().IsOpen());
+    EXPECT_EQ(path, output.Get().Path());
+    EXPECT_EQ(5, ::write(output.Get().Descriptor(), "hello", 5));
+    EXPECT_EQ("hello", ReadFile(path));
+}
+
+TEST_F(OutputFileTest, OverwritePolicyDecidesWhatHappensToExistingFiles)
+{
+    // Arrange
+    auto path = Directory + "/existing.txt";
+    auto open = [&](type::OutputFile::Overwrite policy) {
+        std::ofstream(path) << "old";
+        auto options = type::OutputFile::Options();
+        options.OverwritePolicy = policy;
+        auto file = type::OutputFile::Parse(path);
+        file.Open(options);
+        EXPECT_EQ(3, ::write(file.Descriptor(), "new", 3));
+        return ReadFile(path);
+    };
+
+    // Act & Assert
+    EXPECT_EQ("new", open(type::OutputFile::Overwrite::Truncate));
+    EXPECT_EQ("oldnew", open(type::OutputFile::Overwrite::Append));
+    EXPECT_THROW(open(type::OutputFile::Overwrite::Fail), WhispArgException);
+}
+
+TEST_F(OutputFileTest, ErrorsAreReportedWithOtherViolations)
+{
+    // Arrange
+    std::ofstream(Directory + "/existing.txt") << "old";
+    auto arguments = std::vector<std::string>{"tool",     "--output", Directory + "/existing.txt", "--log",
+                                              Directory + "/missing/log.txt", "--threads", "0"};
+    auto parser = NewParser(arguments);
+    auto options = type::OutputFile::Options();
+    options.OverwritePolicy = type::OutputFile::Overwrite::Fail;
+
+    // Act
+    auto output = ParseOutput(parser, options);
+    auto log = parser.Parse(Argument<type::OutputFile>::New("log"));
+    parser.Parse(Argument<int32_t>::New("threads").Min(1));
+
+    // Assert
+    EXPECT_FALSE(output.Get().IsOpen());
+    EXPECT_FALSE(log.Get().IsOpen());
+    ASSERT_EQ(3u, parser.Violations().size());
+    EXPECT_EQ("Argument \"output\": Cannot open \"" + Directory + "/existing.txt\" for writing: File exists.",
+              parser.Violations()[0]);
+    EXPECT_EQ("Argument \"log\": Cannot open \"" + Directory +
+                  "/missing/log.txt\" for writing: No such file or directory.",
+              parser.Violations()[1]);
+    EXPECT_THROW(parser.Validate(), WhispArgException);
+    EXPECT_EQ("old", ReadFile(Directory + "/existing.txt"));
+}
+
+TEST_F(OutputFileTest, InvalidCommandLinesLeaveTheFileSystemUntouched)
+{
+    // Arrange
+    std::ofstream(Directory + "/results.csv") << "old";
+    auto arguments = std::vector<std::string>{"tool", "--output", Directory + "/results.csv", "--log",
+                                              Directory + "/new.log", "--threads", "0"};
+    auto parser = NewParser(arguments);
+
+    // Act
+    auto output = ParseOutput(parser, type::OutputFile::Options());
+    auto log = parser.Parse(Argument<type::OutputFile>::New("log"));
+    auto report = parser.Parse(
+        Argument<type::OutputFile>::New("report").Default(type::OutputFile::Parse(Directory + "/report.txt")));
+    parser.Parse(Argument<int32_t>::New("threads").Min(1));
+
+    // Assert
+    EXPECT_THROW(parser.Validate(), WhispArgException);
+    EXPECT_EQ("old", ReadFile(Directory + "/results.csv"));
+    EXPECT_FALSE(std::filesystem::exists(Directory + "/new.log"));
+    EXPECT_FALSE(report.Get().IsOpen()); // A default path is not opened implicitly
+    EXPECT_FALSE(std::filesystem::exists(Directory + "/report.txt"));
+}
+
+TEST_F(OutputFileTest, ValidateCommitsTheFiles)
+{
+    // Arrange
+    std::ofstream(Directory + "/results.csv") << "old";
+    auto arguments =
+        std::vector<std::string>{"tool", "--output", Directory + "/results.csv", "--log", Directory + "/new.log"};
+    auto parser = NewParser(arguments);
+    auto options = type::OutputFile::Options();
+    options.OverwritePolicy = type::OutputFile::Overwrite::Fail;
+
+    // Act
+    ParseOutput(parser, type::OutputFile::Options());
+    auto log = parser.Parse(Argument<type::OutputFile>::New("log").OutputOptions(options));
+    auto contentsBeforeValidate = ReadFile(Directory + "/results.csv");
+    auto isLogCreatedBeforeValidate = std::filesystem::exists(Directory + "/new.log");
+    parser.Validate();
+
+    // Assert
+    EXPECT_EQ("old", contentsBeforeValidate);
+    EXPECT_FALSE(isLogCreatedBeforeValidate);
+    EXPECT_EQ("", ReadFile(Directory + "/results.csv"));
+    EXPECT_TRUE(std::filesystem::exists(Directory + "/new.log"));
+    EXPECT_EQ(3, ::write(log.Get().Descriptor(), "log", 3));
+    EXPECT_EQ("log", ReadFile(Directory + "/new.log"));
+}
+
+TEST_F(OutputFileTest, SizeHintReservesSpaceWithoutChangingTheSize)
+{
+    // Arrange
+    auto path = Directory + "/large.bin";
+    auto options = type::OutputFile::Options();
+    options.SizeHint = 1024 * 1024;
+    options.AccessPattern = type::OutputFile::Access::Sequential;
+    auto file = type::OutputFile::Parse(path);
+
+    // Act
+    file.Open(options);
+
+    // Assert
+    struct stat status;
+    ASSERT_EQ(0, ::fstat(file.Descriptor(), &status));
+    EXPECT_EQ(0, status.st_size);
+    if (status.st_blocks > 0) // file systems that cannot preallocate are written to without a reservation
+    {
+        EXPECT_GE(status.st_blocks * 512, 1024 * 1024);
+    }
+}
+
+TEST_F(OutputFileTest, CopiesShareTheDescriptor)
+{
+    // Arrange
+    auto file = type::OutputFile::Parse(Directory + "/shared.txt");
+    file.Open(type::OutputFile::Options());
+
+    // Act
+    auto copy = file;
+    file.Close();
+
+    // Assert
+    EXPECT_FALSE(file.IsOpen());
+    EXPECT_EQ(-1, file.Descriptor());
+    EXPECT_EQ(4, ::write(copy.Descriptor(), "copy", 4));
+    EXPECT_EQ("copy", ReadFile(Directory + "/shared.txt"));
+}
+
+TEST_F(OutputFileTest, DashIsTheStandardOutput)
+{
+    // Arrange
+    auto file = type::OutputFile::Parse("-");
+
+    // Act
+    file.Open(type::OutputFile::Options());
+    file.Close();
+
+    // Assert
+    EXPECT_NE(-1, ::fcntl(STDOUT_FILENO, F_GETFD)); // not closed
+    EXPECT_THROW(type::OutputFile::Parse(""), WhispArgException);
+}
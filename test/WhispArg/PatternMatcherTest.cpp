@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <idofront/WhispArg.hpp>
+#include <string>
+
+using namespace idofront::whisparg;
+
+TEST(PatternMatcherTest, MatchesTheWholeText)
+{
+    // Arrange
+    auto tenant = PatternMatcher::Compile("[a-z0-9-]{3,63}");
+
+    // Act & Assert
+    EXPECT_TRUE(tenant->Matches("acme-01"));
+    EXPECT_TRUE(tenant->Matches(std::string(63, 'a')));
+    EXPECT_FALSE(tenant->Matches("ab"));
+    EXPECT_FALSE(tenant->Matches(std::string(64, 'a')));
+    EXPECT_FALSE(tenant->Matches("Acme"));
+    EXPECT_FALSE(tenant->Matches("acme corp"));
+}
+
+TEST(PatternMatcherTest, SupportsTheRegularSubset)
+{
+    // Act & Assert
+    EXPECT_TRUE(PatternMatcher::Compile("(ab|cd)+e?")->Matches("abcdab"));
+    EXPECT_TRUE(PatternMatcher::Compile("(ab|cd)+e?")->Matches("cde"));
+    EXPECT_FALSE(PatternMatcher::Compile("(ab|cd)+e?")->Matches("e"));
+    EXPECT_TRUE(PatternMatcher::Compile("^v\\d+\\.\\d+(\\.\\d+)?$")->Matches("v1.20.3"));
+    EXPECT_FALSE(PatternMatcher::Compile("^v\\d+\\.\\d+(\\.\\d+)?$")->Matches("v1x20"));
+    EXPECT_TRUE(PatternMatcher::Compile("[^,]*")->Matches("no commas"));
+    EXPECT_FALSE(PatternMatcher::Compile("[^,]*")->Matches("a,b"));
+    EXPECT_TRUE(PatternMatcher::Compile("a.c")->Matches("a-c"));
+    EXPECT_TRUE(PatternMatcher::Compile("x{2,}")->Matches("xxxxx"));
+    EXPECT_FALSE(PatternMatcher::Compile("x{2,}")->Matches("x"));
+    EXPECT_TRUE(PatternMatcher::Compile("(?:a|)b")->Matches("b"));
+    EXPECT_TRUE(PatternMatcher::Compile("[\\w.-]+@[a-z]+")->Matches("first.last-1@example"));
+    EXPECT_TRUE(PatternMatcher::Compile("")->Matches(""));
+}
+
+TEST(PatternMatcherTest, TrailingDollarIsAnAnchorUnlessEscaped)
+{
+    // Act & Assert
+    EXPECT_TRUE(PatternMatcher::Compile("a\\\\$")->Matches("a\\")); // A literal backslash, then the end
+    EXPECT_FALSE(PatternMatcher::Compile("a\\\\$")->Matches("a\\$"));
+    EXPECT_TRUE(PatternMatcher::Compile("a\\$")->Matches("a$")); // An escaped '$'
+    EXPECT_FALSE(PatternMatcher::Compile("a\\$")->Matches("a"));
+    EXPECT_TRUE(PatternMatcher::Compile("a\\\\\\$")->Matches("a\\$"));
+}
+
+TEST(PatternMatcherTest, CompileReusesAutomatons)
+{
+    // Act
+    auto first = PatternMatcher::Compile("[a-f0-9]{8}");
+    auto second = PatternMatcher::Compile("[a-f0-9]{8}");
+
+    // Assert
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ(9u, first->StateCount()); // one state per character read; rejection needs no state
+}
+
+TEST(PatternMatcherTest, CompileRejectsUnsupportedPatterns)
+{
+    // Act & Assert
+    for (const auto &pattern : {"(a", "a)", "[a-", "*a", "a{3,1}", "a{2", "[z-a]", "a\\", "a{1001}"})
+    {
+        EXPECT_THROW(PatternMatcher::Compile(pattern), WhispArgException) << pattern;
+    }
+}
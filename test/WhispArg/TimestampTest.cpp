@@ -0,0 +1,126 @@
+#include <chrono>
+#include <ctime>
+#include <gtest/gtest.h>
+#include <idofront/WhispArg.hpp>
+#include <string>
+#include <vector>
+
+using namespace idofront::whisparg;
+
+namespace
+{
+int64_t Seconds(const type::Timestamp &timestamp)
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(timestamp.TimePoint().time_since_epoch()).count();
+}
+} // namespace
+
+TEST(TimestampTest, ParseReadsIso8601)
+{
+    // Act & Assert
+    EXPECT_EQ(0, Seconds(type::Timestamp::Parse("1970-01-01")));
+    EXPECT_EQ(1790812800, Seconds(type::Timestamp::Parse("2026-10-01T00:00:00Z")));
+    EXPECT_EQ(1790812800 - 9 * 3600, Seconds(type::Timestamp::Parse("2026-10-01T00:00:00+09:00")));
+    EXPECT_EQ(1790812800 + 5400, Seconds(type::Timestamp::Parse("2026-10-01 00:00:00-01:30")));
+    EXPECT_EQ(951782400, Seconds(type::Timestamp::Parse("2000-02-29t00:00:00z")));
+    EXPECT_EQ(-86400, Seconds(type::Timestamp::Parse("1969-12-31T00:00:00Z")));
+    EXPECT_EQ("2026-10-01T12:34:56.789Z", type::Timestamp::Parse("2026-10-01T12:34:56.789000Z").ToString());
+    EXPECT_EQ("1969-12-31T23:59:59.5Z", type::Timestamp::Parse("1969-12-31T23:59:59.5Z").ToString());
+    EXPECT_EQ("2017-01-01T00:00:00Z", type::Timestamp::Parse("2016-12-31T23:59:60Z").ToString());
+}
+
+TEST(TimestampTest, ParseMatchesTimegm)
+{
+    for (auto seconds = int64_t(-2000000000); seconds < 4000000000; seconds += 86399 * 37)
+    {
+        // Arrange
+        auto time = static_cast<time_t>(seconds);
+        std::tm tm;
+        gmtime_r(&time, &tm);
+        char text[32];
+        std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", &tm);
+
+        // Act
+        auto timestamp = type::Timestamp::Parse(text);
+
+        // Assert
+        ASSERT_EQ(seconds, Seconds(timestamp)) << text;
+        ASSERT_EQ(text, timestamp.ToString());
+    }
+}
+
+TEST(TimestampTest, ParseReadsRelativeForms)
+{
+    // Arrange
+    auto now = type::Timestamp::Clock::time_point(std::chrono::seconds(1000000));
+
+    // Act & Assert
+    EXPECT_EQ(1000000, Seconds(type::Timestamp::Parse("now", now)));
+    EXPECT_EQ(1000000 - 7200, Seconds(type::Timestamp::Parse("now-2h", now)));
+    EXPECT_EQ(1000000 + 1800, Seconds(type::Timestamp::Parse("now+30m", now)));
+    EXPECT_EQ(1000000 - 45, Seconds(type::Timestamp::Parse("now-45s", now)));
+    EXPECT_EQ(1000000 - 86400 * 3, Seconds(type::Timestamp::Parse("now-3d", now)));
+    EXPECT_EQ(1000000 + 604800, Seconds(type::Timestamp::Parse("now+1w", now)));
+}
+
+TEST(TimestampTest, ParseRejectsInvalidText)
+{
+    // Arrange
+    auto texts = std::vector<std::string>{"",
+                                          "2026-10-01T00:00:00",
+                                          "2026-1-01",
+                                          "2026-13-01",
+                                          "2026-02-29",
+                                          "2026-10-32",
+                                          "2026-10-01T24:00:00Z",
+                                          "2026-10-01T00:60:00Z",
+                                          "2026-10-01T00:00:00.Z",
+                                          "2026-10-01T00:00:00+0900",
+                                          "2026-10-01T00:00:00Zx",
+                                          "2026-10-01X00:00:00Z",
+                                          "now-",
+                                          "now-2",
+                                          "now-2y",
+                                          "now2h",
+                                          "now-x2h",
+                                          "now-99999999999999999999s"};
+
+    for (const auto &text : texts)
+    {
+        // Act & Assert
+        EXPECT_THROW(type::Timestamp::Parse(text), WhispArgException) << text;
+    }
+}
+
+TEST(TimestampTest, ParseRejectsTimestampsOutsideTheClockRange)
+{
+    // Arrange
+    auto now = type::Timestamp::Clock::time_point(std::chrono::seconds(1000000));
+
+    // Act & Assert
+    EXPECT_THROW(type::Timestamp::Parse("2300-01-01T00:00:00Z"), WhispArgException);
+    EXPECT_THROW(type::Timestamp::Parse("0001-01-01T00:00:00Z"), WhispArgException);
+    EXPECT_THROW(type::Timestamp::Parse("now-99999999w", now), WhispArgException);
+    EXPECT_THROW(type::Timestamp::Parse("now+99999999w", now), WhispArgException);
+    EXPECT_THROW(type::Timestamp::Parse("now+1d", type::Timestamp::Clock::time_point::max() - std::chrono::hours(1)),
+                 WhispArgException);
+    EXPECT_EQ("2200-01-01T00:00:00Z", type::Timestamp::Parse("2200-01-01T00:00:00Z").ToString());
+    EXPECT_EQ("1700-01-01T00:00:00Z", type::Timestamp::Parse("1700-01-01T00:00:00Z").ToString());
+}
+
+TEST(TimestampTest, WhispArgReadsTheClockOnce)
+{
+    // Arrange
+    std::string arguments[] = {"tool", "--since", "now-2h", "--until", "now"};
+    char *argv[] = {arguments[0].data(), arguments[1].data(), arguments[2].data(), arguments[3].data(),
+                    arguments[4].data(), nullptr};
+    auto parser = WhispArg(5, argv);
+
+    // Act
+    auto since = parser.Parse(Argument<type::Timestamp>::New("since")).Value().value();
+    auto until = parser.Parse(Argument<type::Timestamp>::New("until")).Value().value();
+
+    // Assert
+    EXPECT_EQ(std::chrono::hours(2), until.TimePoint() - since.TimePoint());
+    EXPECT_EQ(parser.Now(), until.TimePoint());
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <idofront/WhispArg.hpp>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace idofront::whisparg;
+
+namespace
+{
+void WriteAll(int fd, const std::string &text)
+{
+    ASSERT_EQ(static_cast<ssize_t>(text.size()), ::write(fd, text.data(), text.size()));
+}
+
+std::vector<std::string> ReadAll(TokenStream &stream)
+{
+    auto tokens = std::vector<std::string>();
+    auto token = std::string();
+    while (stream.Next(token))
+    {
+        tokens.push_back(token);
+    }
+    return tokens;
+}
+} // namespace
+
+TEST(TokenStreamTest, ReadsNulDelimitedTokensAcrossBufferBoundaries)
+{
+    // Arrange
+    int fds[2];
+    ASSERT_EQ(0, ::pipe(fds));
+    WriteAll(fds[1], std::string("./a\0./directory/b\0\0./c with space", 33));
+    ::close(fds[1]);
+
+    // Act
+    // A buffer smaller than a token forces tokens to be assembled from several reads.
+    auto stream = TokenStream(fds[0], '\0', 4);
+    auto tokens = ReadAll(stream);
+    ::close(fds[0]);
+
+    // Assert
+    auto expected = std::vector<std::string>{"./a", "./directory/b", "./c with space"};
+    EXPECT_EQ(expected, tokens);
+}
+
+TEST(TokenStreamTest, ReturnsTokensBeforeTheInputIsComplete)
+{
+    // Arrange
+    int fds[2];
+    ASSERT_EQ(0, ::pipe(fds));
+    auto stream = TokenStream(fds[0]);
+
+    // Act & Assert
+    // The first token is available while the writer is still open.
+    WriteAll(fds[1], "first\nsec");
+    EXPECT_EQ("first", stream.Next().value());
+
+    WriteAll(fds[1], "ond\n");
+    EXPECT_EQ("second", stream.Next().value());
+
+    ::close(fds[1]);
+    EXPECT_FALSE(stream.Next().has_value());
+    EXPECT_FALSE(stream.Next().has_value());
+    ::close(fds[0]);
+}
+
+TEST(TokenStreamTest, InvalidDescriptorThrows)
+{
+    // Arrange
+    auto stream = TokenStream(-1);
+
+    // Act & Assert
+    EXPECT_THROW(stream.Next(), WhispArgException);
+}
+
+TEST(TokenStreamTest, WhispArgParsesArgumentsFromADescriptor)
+{
+    // Arrange
+    int fds[2];
+    ASSERT_EQ(0, ::pipe(fds));
+    WriteAll(fds[1], std::string("--input\0./data/a b.csv\0--threads\0" "8\0", 35));
+    ::close(fds[1]);
+    std::string arguments[] = {"tool", "--args-from-stdin", "--name", "job"};
+    char *argv[] = {arguments[0].data(), arguments[1].data(), arguments[2].data(), arguments[3].data(), nullptr};
+    auto parser = WhispArg(4, argv);
+
+    // Act
+    auto isFromStdin = parser.Parse(ArgumentsFromStdinArgument).Get();
+    if (isFromStdin)
+    {
+        parser = parser.ArgumentsFrom(fds[0], '\0');
+    }
+    ::close(fds[0]);
+    auto name = parser.Parse(Argument<std::string>::New("name"));
+    auto input = parser.Parse(Argument<std::string>::New("input"));
+    auto threads = parser.Parse(Argument<int32_t>::New("threads"));
+
+    // Assert
+    EXPECT_TRUE(isFromStdin);
+    EXPECT_EQ("job", name.Get());
+    EXPECT_EQ("./data/a b.csv", input.Get());
+    EXPECT_EQ(8, threads.Get());
+}
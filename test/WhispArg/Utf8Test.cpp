@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <idofront/WhispArg.hpp>
+#include <random>
+#include <string>
+
+using namespace idofront::whisparg;
+
+namespace
+{
+/// @brief Validates UTF-8 one code point at a time, as a reference for FindInvalidUtf8().
+std::size_t FindInvalidUtf8Slowly(const std::string &text)
+{
+    for (auto i = std::size_t(0); i < text.size();)
+    {
+        auto lead = static_cast<unsigned char>(text[i]);
+        auto length = lead < 0x80 ? 1 : lead >> 5 == 0x6 ? 2 : lead >> 4 == 0xE ? 3 : lead >> 3 == 0x1E ? 4 : 0;
+        if (length == 0 || i + length > text.size())
+        {
+            return i;
+        }
+        auto codePoint = static_cast<uint32_t>(length == 1 ? lead : lead & (0x7F >> length));
+        for (auto j = 1; j < length; j++)
+        {
+            auto c = static_cast<unsigned char>(text[i + j]);
+            if ((c & 0xC0) != 0x80)
+            {
+                return i;
+            }
+            codePoint = (codePoint << 6) | (c & 0x3F);
+        }
+        auto minimum = length == 1 ? 0u : length == 2 ? 0x80u : length == 3 ? 0x800u : 0x10000u;
+        if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+        {
+            return i;
+        }
+        i += length;
+    }
+    return std::string::npos;
+}
+} // namespace
+
+TEST(Utf8Test, FindInvalidUtf8AcceptsWellFormedText)
+{
+    // Act & Assert
+    EXPECT_TRUE(IsValidUtf8(""));
+    EXPECT_TRUE(IsValidUtf8(std::string(100, 'a')));
+    EXPECT_TRUE(IsValidUtf8("caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80 \xED\x9F\xBF \xF4\x8F\xBF\xBF"));
+}
+
+TEST(Utf8Test, FindInvalidUtf8RejectsMalformedSequences)
+{
+    // Act & Assert
+    EXPECT_EQ(40u, FindInvalidUtf8(std::string(40, 'a') + "\xFF" + std::string(40, 'a')));
+    EXPECT_EQ(0u, FindInvalidUtf8("\xC0\xAF"));         // overlong '/'
+    EXPECT_EQ(0u, FindInvalidUtf8("\xE0\x80\xAF"));     // overlong '/'
+    EXPECT_EQ(0u, FindInvalidUtf8("\xED\xA0\x80"));     // surrogate U+D800
+    EXPECT_EQ(0u, FindInvalidUtf8("\xF4\x90\x80\x80")); // U+110000
+    EXPECT_EQ(1u, FindInvalidUtf8("a\xE2\x82"));        // truncated at the end
+    EXPECT_EQ(0u, FindInvalidUtf8("\x80"));             // continuation without a lead byte
+}
+
+TEST(Utf8Test, FindInvalidUtf8AgreesWithAReferenceDecoder)
+{
+    // Arrange
+    auto random = std::mt19937(42);
+    auto pieces = std::vector<std::string>{"a", "z", " ", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\x80",
+                                           "\xC0", "\xED\xA0\x80", "\xF5", "\xE2", std::string(40, 'x')};
+
+    for (auto i = 0; i < 2000; i++)
+    {
+        auto text = std::string();
+        auto count = std::uniform_int_distribution<int>(0, 12)(random);
+        for (auto j = 0; j < count; j++)
+        {
+            // Valid pieces are picked more often, so that invalid bytes also appear after long valid runs.
+            auto index = std::uniform_int_distribution<std::size_t>(0, pieces.size() * 4 - 1)(random);
+            text += pieces[index < pieces.size() ? index : std::vector<std::size_t>{0, 3, 4, 5, 11}[index % 5]];
+        }
+
+        // Act & Assert
+        EXPECT_EQ(FindInvalidUtf8Slowly(text), FindInvalidUtf8(text)) << text;
+    }
+}
+
+TEST(Utf8Test, CountCodePointsCountsLeadBytes)
+{
+    // Act & Assert
+    EXPECT_EQ(0u, CountCodePoints(""));
+    EXPECT_EQ(4u, CountCodePoints("caf\xC3\xA9"));
+    EXPECT_EQ(3u, CountCodePoints("\xE2\x82\xAC\xF0\x9F\x98\x80!"));
+    EXPECT_EQ(std::optional<std::string>("invalid byte 0xFF at offset 1"), DescribeInvalidUtf8("a\xFF"));
+    EXPECT_FALSE(DescribeInvalidUtf8("ok").has_value());
+}
@@ -0,0 +1,635 @@
+#include <algorithm>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <idofront/WhispArg.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace idofront::whisparg;
+
+namespace
+{
+/// @brief Holds command-line arguments and exposes them as argc/argv.
+class CommandLine
+{
+  public:
+    CommandLine(std::vector<std::string> arguments) : _Arguments(std::move(arguments))
+    {
+        for (auto &argument : _Arguments)
+        {
+            _Pointers.push_back(argument.data());
+        }
+        _Pointers.push_back(nullptr);
+    }
+
+    int Argc()
+    {
+        return static_cast<int>(_Arguments.size());
+    }
+
+    char **Argv()
+    {
+        return _Pointers.data();
+    }
+
+  private:
+    std::vector<std::string> _Arguments;
+    std::vector<char *> _Pointers;
+};
+
+std::string CaptureHelp(WhispArg &parser, std::size_t maxWidth)
+{
+    auto output = std::ostringstream();
+    auto original = std::cout.rdbuf(output.rdbuf());
+    parser.ShowHelp(maxWidth);
+    std::cout.rdbuf(original);
+    return output.str();
+}
+} // namespace
+
+TEST(WhispArgTest, ShowHelpWritesHelpString)
+{
+    // Arrange
+    auto commandLine = CommandLine({"tool"});
+    auto parser = WhispArg(commandLine.Argc(), commandLine.Argv()).Name("tool").Version("v1");
+    parser.Parse(Argument<int32_t>::New('n', "number").Description("A number."));
+
+    // Act
+    auto help = CaptureHelp(parser, 80);
+
+    // Assert
+    EXPECT_EQ(parser.HelpString(80), help);
+    EXPECT_EQ(0u, help.find("tool v1\n"));
+    EXPECT_NE(std::string::npos, help.find("--number (-n) <NUMBER>  A number.\n"));
+}
+
+TEST(WhispArgTest, HelpStringIsCachedPerWidthUntilArgumentsChange)
+{
+    // Arrange
+    auto commandLine = CommandLine({"tool"});
+    auto parser = WhispArg(commandLine.Argc(), commandLine.Argv());
+    parser.Parse(Argument<int32_t>::New("number").Description("A number."));
+
+    // Act
+    auto firstData = parser.HelpString(80).data();
+    auto secondData = parser.HelpString(80).data();
+    auto second = parser.HelpString(80);
+    auto narrow = parser.HelpString(20);
+    parser.Parse(Argument<std::string>::New("message").Description("A message."));
+    auto updated = parser.HelpString(80);
+
+    // Assert
+    // The second call returns the cached text without laying it out again.
+    EXPECT_EQ(firstData, secondData);
+    EXPECT_NE(second, narrow);
+    EXPECT_EQ(std::string::npos, second.find("--message"));
+    EXPECT_NE(std::string::npos, updated.find("--message"));
+}
+
+TEST(WhispArgTest, DetectTerminalWidthUsesColumnsWhenNotATerminal)
+{
+    if (isatty(STDOUT_FILENO))
+    {
+        GTEST_SKIP() << "The standard output is a terminal.";
+    }
+
+    // Arrange
+    setenv("COLUMNS", "123", 1);
+
+    // Act & Assert
+    EXPECT_EQ(123u, WhispArg::DetectTerminalWidth());
+
+    // Arrange
+    unsetenv("COLUMNS");
+
+    // Act & Assert
+    EXPECT_EQ(80u, WhispArg::DetectTerminalWidth());
+    EXPECT_GT(WhispArg::TerminalWidth(), 0u);
+}
+
+TEST(WhispArgTest, HelpStringGroupsArgumentsBySectionAndOmitsAdvancedOnes)
+{
+    // Arrange
+    auto commandLine = CommandLine({"tool"});
+    auto parser = WhispArg(commandLine.Argc(), commandLine.Argv());
+    parser.Parse(Argument<std::string>::New("tls-cert").Description("Certificate file.").Section("TLS"));
+    parser.Parse(Argument<int32_t>::New("threads").Description("Worker threads."));
+    parser.Parse(Argument<std::string>::New("tls-ciphers").Description("Cipher list.").Section("TLS").IsAdvanced(true));
+
+    // Act
+    auto help = parser.HelpString(80);
+
+    // Assert
+    auto options = help.find("Options:\n");
+    auto threads = help.find("--threads");
+    auto tls = help.find("TLS:\n");
+    auto certificate = help.find("--tls-cert");
+    EXPECT_LT(options, threads);
+    EXPECT_LT(threads, tls);
+    EXPECT_LT(tls, certificate);
+    EXPECT_NE(std::string::npos, certificate);
+    EXPECT_EQ(std::string::npos, help.find("--tls-ciphers"));
+    EXPECT_NE(std::string::npos, help.find("Use --help=all to show all options."));
+}
+
+TEST(WhispArgTest, HelpStringFiltersByTopic)
+{
+    // Arrange
+    auto commandLine = CommandLine({"tool", "--help=tls"});
+    auto parser = WhispArg(commandLine.Argc(), commandLine.Argv());
+    parser.Parse(Argument<std::string>::New("cert").Description("Certificate file.").Section("TLS"));
+    parser.Parse(Argument<int32_t>::New("threads").Description("Worker threads."));
+    parser.Parse(Argument<std::string>::New("ciphers").Description("Cipher list for TLS.").IsAdvanced(true));
+
+    // Act
+    auto topic = parser.HelpTopic();
+    auto section = parser.HelpString(80, "tls");
+    auto keyword = parser.HelpString(80, "Worker");
+    auto all = parser.HelpString(80, "all");
+    auto none = parser.HelpString(80, "nothing");
+
+    // Assert
+    EXPECT_EQ("tls", topic.value());
+
+    // A section name takes precedence over keywords.
+    EXPECT_NE(std::string::npos, section.find("--cert"));
+    EXPECT_EQ(std::string::npos, section.find("--ciphers"));
+    EXPECT_EQ(std::string::npos, section.find("--threads"));
+
+    EXPECT_NE(std::string::npos, keyword.find("--threads"));
+    EXPECT_EQ(std::string::npos, keyword.find("--cert"));
+
+    EXPECT_NE(std::string::npos, all.find("--cert"));
+    EXPECT_NE(std::string::npos, all.find("--threads"));
+    EXPECT_NE(std::string::npos, all.find("--ciphers"));
+
+    EXPECT_NE(std::string::npos, none.find("No options match \"nothing\"."));
+}
+
+TEST(WhispArgTest, HelpStringFindsAdvancedArgumentsByKeyword)
+{
+    // Arrange
+    auto commandLine = CommandLine({"tool"});
+    auto parser = WhispArg(commandLine.Argc(), commandLine.Argv());
+    parser.Parse(Argument<std::string>::New("ciphers").Description("Cipher list for TLS.").IsAdvanced(true));
+
+    // Act
+    auto help = parser.HelpString(80, "TLS");
+
+    // Assert
+    EXPECT_NE(std::string::npos, help.find("--ciphers"));
+}
+
+TEST(WhispArgTest, SchemaDescribesParsedArguments)
+{
+    // Arrange
+    auto commandLine = CommandLine({"/usr/bin/tool", "--whisparg-schema"});
+    auto parser = WhispArg(commandLine.Argc(), commandLine.Argv()).Version("v1").Description("Say \"hi\".");
+    parser.Parse(Argument<uint16_t>::New('p', "port").Description("Port.").Default(8080).Section("Network"));
+    parser.Parse(Argument<std::string>::New("name").IsRequired(false).Default("a\\b"));
+    parser.Parse(Argument<type::Flag>::New("verbose"));
+
+    // Act
+    auto schema = parser.Schema();
+
+    // Assert
+    EXPECT_TRUE(parser.IsSchemaRequested());
+    EXPECT_EQ("{\"name\":\"tool\",\"version\":\"v1\",\"description\":\"Say \\\"hi\\\".\",\"arguments\":["
+              "{\"name\":\"port\",\"shortName\":\"p\",\"type\":\"integer\",\"cppType\":\"uint16_t\","
+              "\"description\":\"Port.\",\"required\":false,\"flag\":false,\"default\":8080,\"section\":\"Network\","
+              "\"advanced\":false},"
+              "{\"name\":\"name\",\"type\":\"string\",\"cppType\":\"std::string\",\"description\":\"\","
+              "\"required\":false,\"flag\":false,\"default\":\"a\\\\b\",\"advanced\":false},"
+              "{\"name\":\"verbose\",\"type\":\"boolean\",\"cppType\":\"idofront::whisparg::type::Flag\","
+              "\"description\":\"\",\"required\":false,\"flag\":true,\"default\":false,\"advanced\":false}]}",
+              schema);
+}
+
+TEST(WhispArgTest, SchemaWritesFloatingPointValuesExactly)
+{
+    // Arrange
+    auto commandLine = CommandLine({"tool"});
+    auto parser = WhispArg(commandLine.Argc(), commandLine.Argv());
+    parser.Parse(Argument<double>::New("ratio").Default(0.1234567891).Max(0.1));
+    parser.Parse(Argument<double>::New("limit").Default(std::numeric_limits<double>::infinity()));
+    parser.Parse(Argument<float>::New("scale").Default(std::numeric_limits<float>::quiet_NaN()));
+
+    // Act
+    auto schema = parser.Schema();
+
+    // Assert
+    EXPECT_NE(std::string::npos, schema.find("\"default\":0.1234567891,\"maximum\":0.1,"));
+    EXPECT_NE(std::string::npos, schema.find("\"name\":\"limit\"")) << schema;
+    EXPECT_EQ(std::string::npos, schema.find("inf")) << schema;
+    EXPECT_EQ(std::string::npos, schema.find("nan")) << schema;
+    EXPECT_EQ("0.30000000000000004", ToJsonValue(0.1 + 0.2).value());
+    EXPECT_EQ("null", ToJsonValue(-std::numeric_limits<double>::infinity()).value());
+}
+
+TEST(WhispArgTest, TypeNameIsACompileTimeConstant)
+{
+    // Act
+    constexpr auto name = TypeName<double>();
+    constexpr auto jsonType = JsonTypeName<int8_t>();
+
+    // Assert
+    static_assert(name == "double");
+    static_assert(jsonType == "integer");
+    EXPECT_EQ("int64_t", TypeName<int64_t>());
+}
+
+TEST(WhispArgTest, TypeNameQualifiesLibraryTypesTheSameOnEveryCompiler)
+{
+    // Act
+    constexpr auto bounded = TypeName<type::Bounded<int32_t, -1, 256>>();
+    constexpr auto list = TypeName<type::List<std::string>>();
+
+    // Assert
+    static_assert(bounded == "idofront::whisparg::type::Bounded<int32_t, -1, 256>");
+    static_assert(list == "idofront::whisparg::type::List<std::string>");
+    EXPECT_EQ("idofront::whisparg::type::Timestamp", TypeName<type::Timestamp>());
+    EXPECT_EQ("idofront::whisparg::type::List<idofront::whisparg::type::Bounded<uint64_t, 0, 18446744073709551615>>",
+              (TypeName<type::List<type::Bounded<uint64_t, 0, UINT64_MAX>>>()));
+    EXPECT_EQ("idofront::whisparg::type::Bounded<int64_t, -9223372036854775808, 0>",
+              (TypeName<type::Bounded<int64_t, INT64_MIN, 0>>()));
+}
+
+TEST(WhispArgTest, ParseMatchesParseFunction)
+{
+    // Arrange
+    auto commandLines = std::vector<std::vector<std::string>>{
+        {"tool", "-t", "-t", "-t", "x", "-f"},
+        {"tool", "--text", "-f", "--flag", "-t", ""},
+        {"tool", "-f", "-t", "--text", "--text", "last"},
+    };
+    auto flag = Argument<type::Flag>::New('f', "flag");
+    auto text = Argument<std::string>::New('t', "text").Default("none");
+
+    for (const auto &arguments : commandLines)
+    {
+        auto commandLine = CommandLine(arguments);
+        auto parser = WhispArg(commandLine.Argc(), commandLine.Argv());
+
+        // Act & Assert
+        EXPECT_EQ(Parse(arguments, flag), parser.Parse(flag).Value());
+        EXPECT_EQ(Parse(arguments, text), parser.Parse(text).Value());
+    }
+}
+
+TEST(WhispArgTest, ProfileValuesOverrideDefaultsButNotTheCommandLine)
+{
+    // Arrange
+    static constexpr ProfileEntry LowLatency[] = {{"threads", "4"}, {"batch-size", "1"}, {"verbose", "true"}};
+    static constexpr ProfileEntry Batch[] = {{"threads", "64"}, {"batch-size", "1024"}};
+    auto commandLine = CommandLine({"tool", "--profile", "low-latency", "--threads", "8"});
+    auto parser = WhispArg(commandLine.Argc(), commandLine.Argv())
+                      .AddProfile(Profile("low-latency", LowLatency))
+                      .AddProfile(Profile("batch", Batch));
+
+    // Act
+    auto profile = parser.Parse(ProfileArgument);
+    auto threads = parser.Parse(Argument<int32_t>::New("threads").Default(1));
+    auto batchSize = parser.Parse(Argument<int32_t>::New("batch-size").Default(16));
+    auto verbose = parser.Parse(Argument<type::Flag>::New("verbose"));
+    auto timeout = parser.Parse(Argument<int32_t>::New("timeout").Default(30));
+
+    // Assert
+    EXPECT_EQ("low-latency", profile.Value().value());
+    EXPECT_EQ(8, threads.Value().value());   // The command line wins
+    EXPECT_EQ(1, batchSize.Value().value()); // The profile overrides the default
+    EXPECT_TRUE(verbose.Value().value());    // A flag in a profile gives the value itself
+    EXPECT_EQ(30, timeout.Value().value());  // Not in the profile
+}
+
+TEST(WhispArgTest, UndefinedProfileThrows)
+{
+    // Arrange
+    static constexpr ProfileEntry Batch[] = {{"threads", "64"}};
+    auto commandLine = CommandLine({"tool", "--profile", "unknown"});
+    auto parser = WhispArg(commandLine.Argc(), commandLine.Argv()).AddProfile(Profile("batch", Batch));
+
+    // Act & Assert
+    EXPECT_THROW(parser.Parse(Argument<int32_t>::New("threads")), WhispArgException);
+}
+
+TEST(WhispArgTest, InterpolateExpandsEnvironmentVariablesAndArguments)
+{
+    // Arrange
+    setenv("WHISPARG_TEST_WORKDIR", "/work", 1);
+    auto commandLine = CommandLine({"tool", "--out", "${WHISPARG_TEST_WORKDIR}/shard-${arg:shard}.bin", "--shard",
+                                    "${arg:index}", "--price", "$$5 $x"});
+    auto shardArgument = Argument<int32_t>::New("shard");
+    auto parser = WhispArg(commandLine.Argc(), commandLine.Argv()).Interpolate(true).Declare(shardArgument);
+
+    // Act
+    auto index = parser.Parse(Argument<int32_t>::New("index").Default(3));
+    auto out = parser.Parse(Argument<std::string>::New("out"));
+    auto shard = parser.Parse(shardArgument);
+    auto price = parser.Parse(Argument<std::string>::New("price"));
+    unsetenv("WHISPARG_TEST_WORKDIR");
+
+    // Assert
+    EXPECT_EQ(3, index.Value().value());
+    EXPECT_EQ("/work/shard-3.bin", out.Value().value()); // The declared --shard is resolved before it is parsed
+    EXPECT_EQ(3, shard.Value().value());
+    EXPECT_EQ("$5 $x", price.Value().value());
+}
+
+TEST(WhispArgTest, InterpolateDoesNotDependOnTheParseOrder)
+{
+    // Arrange
+    auto shard = Argument<int32_t>::New('s', "shard").Default(7);
+    auto verbose = Argument<type::Flag>::New('v', "verbose");
+    auto out = Argument<std::string>::New("out");
+    auto commandLines = std::vector<std::vector<std::string>>{
+        {"tool", "--out", "x-${arg:shard}-${arg:verbose}", "-s", "3", "-v", "--other"},
+        {"tool", "--out", "x-${arg:shard}-${arg:verbose}"}};
+    auto expected = std::vector<std::string>{"x-3-true", "x-7-false"};
+
+    for (auto i = std::size_t(0); i < commandLines.size(); i++)
+    {
+        for (auto isOutFirst : {true, false})
+        {
+            // Act
+            auto commandLine = CommandLine(commandLines[i]);
+            auto parser =
+                WhispArg(commandLine.Argc(), commandLine.Argv()).Interpolate(true).Declare(shard).Declare(verbose);
+            if (!isOutFirst)
+            {
+                parser.Parse(shard);
+                parser.Parse(verbose);
+            }
+            auto value = parser.Parse(out).Value().value();
+
+            // Assert
+            EXPECT_EQ(expected[i], value) << i << (isOutFirst ? " out first" : " out last");
+        }
+    }
+}
+
+TEST(WhispArgTest, InterpolateIsOptIn)
+{
+    // Arrange
+    auto commandLine = CommandLine({"tool", "--out", "${arg:shard}"});
+    auto parser = WhispArg(commandLine.Argc(), commandLine.Argv());
+
+    // Act
+    auto out = parser.Parse(Argument<std::string>::New("out"));
+
+    // Assert
+    EXPECT_EQ("${arg:shard}", out.Value().value());
+}
+
+TEST(WhispArgTest, InterpolateThrowsOnInvalidReferences)
+{
+    // Arrange
+    unsetenv("WHISPARG_TEST_UNSET");
+    auto commandLine = CommandLine({"tool", "--a", "${arg:b}", "--b", "x${arg:a}", "--c", "${WHISPARG_TEST_UNSET}",
+                                    "--d", "${arg:missing}", "--e", "${arg:e"});
+    auto parser = WhispArg(commandLine.Argc(), commandLine.Argv())
+                      .Interpolate(true)
+                      .Declare(Argument<std::string>::New("a"))
+                      .Declare(Argument<std::string>::New("b"));
+
+    // Act & Assert
+    for (auto name : {"a", "b", "c", "d", "e"})
+    {
+        EXPECT_THROW(parser.Parse(Argument<std::string>::New(name)), WhispArgException) << name;
+    }
+}
+
+TEST(WhispArgTest, ValidateReportsAllViolationsTogether)
+{
+    // Arrange
+    auto commandLine = CommandLine({"tool", "--threads", "0", "--ratio", "1.5", "--mode", "safe"});
+    auto parser = WhispArg(commandLine.Argc(), commandLine.Argv());
+
+    // Act
+    auto threads = parser.Parse(Argument<int32_t>::New("threads").Min(1).Max(256));
+    auto ratio = parser.Parse(Argument<double>::New("ratio").Min(0.0).Max(1.0));
+    auto mode = parser.Parse(Argument<std::string>::New("mode").OneOf({"fast", "safe"}));
+
+    // Assert
+    EXPECT_EQ(0, threads.Value().value()); // Parse() does not throw for violations
+    EXPECT_EQ(2u, parser.Violations().size());
+    try
+    {
+        parser.Validate();
+        FAIL() << "Validate() did not throw.";
+    }
+    catch (const WhispArgException &e)
+    {
+        EXPECT_STREQ("Argument \"threads\" must be at least 1.\nArgument \"ratio\" must be at most 1.", e.what());
+    }
+}
+
+TEST(WhispArgTest, IntegerConvertersRejectOutOfRangeValues)
+{
+    // Act & Assert
+    EXPECT_EQ(-128, Parse({"tool", "--n", "-128"}, Argument<int8_t>::New("n")).value());
+    EXPECT_EQ(255, Parse({"tool", "--n", "255"}, Argument<uint8_t>::New("n")).value());
+    EXPECT_THROW(Parse({"tool", "--n", "128"}, Argument<int8_t>::New("n")), WhispArgException);
+    EXPECT_THROW(Parse({"tool", "--n", "256"}, Argument<uint8_t>::New("n")), WhispArgException);
+    EXPECT_THROW(Parse({"tool", "--n", "-1"}, Argument<uint32_t>::New("n")), WhispArgException);
+    EXPECT_THROW(Parse({"tool", "--n", "4294967296"}, Argument<uint32_t>::New("n")), WhispArgException);
+    EXPECT_THROW(Parse({"tool", "--n", "5"}, Argument<int32_t>::New("n").Max(4)), WhispArgException);
+}
+
+TEST(WhispArgTest, BoundedChecksCompileTimeLimits)
+{
+    // Arrange
+    using Threads = type::Bounded<uint16_t, 1, 256>;
+    auto commandLine = CommandLine({"tool", "--threads", "256", "--other", "257"});
+    auto parser = WhispArg(commandLine.Argc(), commandLine.Argv());
+
+    // Act
+    auto threads = parser.Parse(Argument<Threads>::New("threads").Default(Threads(4)));
+
+    // Assert
+    EXPECT_EQ(256, threads.Value().value());
+    EXPECT_THROW(parser.Parse(Argument<Threads>::New("other")), WhispArgException);
+    EXPECT_THROW(Threads(0), WhispArgException);
+    auto schema = parser.Schema();
+    EXPECT_NE(std::string::npos, schema.find("{\"name\":\"threads\",\"type\":\"integer\""));
+    EXPECT_NE(std::string::npos, schema.find("\"default\":4,\"minimum\":1,\"maximum\":256"));
+}
+
+TEST(WhispArgTest, ParseStoresTheDefaultValueAsTheValue)
+{
+    // Arrange
+    auto commandLine = CommandLine({"tool", "--given", "value"});
+    auto parser = WhispArg(commandLine.Argc(), commandLine.Argv());
+
+    // Act
+    auto given = parser.Parse(Argument<std::string>::New("given").Default("default"));
+    auto omitted = parser.Parse(Argument<std::string>::New("omitted").Default("default"));
+    auto missing = parser.Parse(Argument<std::string>::New("missing"));
+
+    // Assert
+    EXPECT_EQ("value", given.Get());
+    EXPECT_EQ("default", omitted.Get());
+    EXPECT_EQ("default", omitted.Value().value());
+    EXPECT_FALSE(missing.Value().has_value());
+}
+
+TEST(WhispArgTest, DefaultFromIsNotEvaluatedWhenAValueIsGiven)
+{
+    // Arrange
+    static constexpr ProfileEntry Preset[] = {{"given", "from-profile"}};
+    auto calls = 0;
+    auto factory = [&calls]() {
+        calls++;
+        return std::string("computed");
+    };
+    auto givenArgument = Argument<std::string>::New("given").DefaultFrom(factory, "<computed>");
+    auto commandLine = CommandLine({"tool", "--given", "value", "--out", "x-${arg:given}"});
+    auto parser = WhispArg(commandLine.Argc(), commandLine.Argv());
+    auto interpolated = WhispArg(commandLine.Argc(), commandLine.Argv()).Interpolate(true);
+    auto declared = WhispArg(commandLine.Argc(), commandLine.Argv()).Interpolate(true).Declare(givenArgument);
+    auto emptyCommandLine = CommandLine({"tool", "--profile", "preset"});
+    auto configured = WhispArg(emptyCommandLine.Argc(), emptyCommandLine.Argv())
+                          .Config(JsonSource::FromString(R"({"given": "from-config"})"));
+    auto profiled = WhispArg(emptyCommandLine.Argc(), emptyCommandLine.Argv()).AddProfile(Profile("preset", Preset));
+
+    // Act
+    auto given = parser.Parse(givenArgument);
+    auto configuredGiven = configured.Parse(givenArgument);
+    profiled.Parse(ProfileArgument);
+    auto profiledGiven = profiled.Parse(givenArgument);
+    auto interpolatedGiven = interpolated.Parse(givenArgument);
+    auto interpolatedOut = interpolated.Parse(Argument<std::string>::New("out"));
+    auto declaredOut = declared.Parse(Argument<std::string>::New("out")); // Resolves the declared argument first
+    auto declaredGiven = declared.Parse(givenArgument);
+    auto callsAfterGiven = calls;
+    auto omitted = parser.Parse(Argument<std::string>::New("omitted").DefaultFrom(factory));
+    auto schema = parser.Schema();
+
+    // Assert
+    EXPECT_EQ(0, callsAfterGiven);
+    EXPECT_EQ("value", given.Get());
+    EXPECT_EQ("from-config", configuredGiven.Get());
+    EXPECT_EQ("from-profile", profiledGiven.Get());
+    EXPECT_EQ("value", interpolatedGiven.Get());
+    EXPECT_EQ("x-value", interpolatedOut.Get());
+    EXPECT_EQ("x-value", declaredOut.Get());
+    EXPECT_EQ("value", declaredGiven.Get());
+    EXPECT_EQ("computed", omitted.Get());
+    EXPECT_EQ(1, calls);
+    EXPECT_NE(std::string::npos, schema.find("\"defaultPlaceholder\":\"<computed>\""));
+}
+
+TEST(WhispArgTest, ToArgvRebuildsTheResolvedCommandLine)
+{
+    // Arrange
+    static constexpr ProfileEntry Batch[] = {{"threads", "64"}};
+    auto commandLine =
+        CommandLine({"/usr/bin/tool", "-s", "1", "--profile", "batch", "-v", "--name", "a b", "--unknown", "x"});
+    auto parser = WhispArg(commandLine.Argc(), commandLine.Argv()).AddProfile(Profile("batch", Batch));
+    parser.Parse(ProfileArgument);
+    parser.Parse(Argument<int32_t>::New('s', "shard"));
+    parser.Parse(Argument<int32_t>::New("threads").Default(1));
+    parser.Parse(Argument<int32_t>::New("timeout").Default(30));
+    parser.Parse(Argument<type::Flag>::New('v', "verbose"));
+    parser.Parse(Argument<type::Flag>::New("color").Default(type::Flag::True));
+    parser.Parse(Argument<std::string>::New("name"));
+
+    // Act
+    auto argv = parser.ToArgv();
+    auto overridden =
+        parser.ToArgv({{"shard", "2"}, {"verbose", "false"}, {"color", "false"}, {"extra", "e"}, {"shard", "3"}});
+
+    // Assert
+    EXPECT_EQ((std::vector<std::string>{"/usr/bin/tool", "--profile", "batch", "--shard", "1", "--threads", "64",
+                                        "--verbose", "--name", "a b"}),
+              argv.ToVector());
+    EXPECT_EQ(10, argv.Argc());
+    EXPECT_EQ(nullptr, argv.Argv()[10]);
+    EXPECT_EQ((std::vector<std::string>{"/usr/bin/tool", "--profile", "batch", "--shard", "2", "--threads", "64",
+                                        "--color", "--name", "a b", "--extra", "e"}),
+              overridden.ToVector());
+
+    // The rebuilt command line parses to the same values.
+    auto child =
+        WhispArg(overridden.Argc(), const_cast<char **>(overridden.Argv())).AddProfile(Profile("batch", Batch));
+    EXPECT_EQ(2, child.Parse(Argument<int32_t>::New('s', "shard")).Get());
+    EXPECT_EQ(64, child.Parse(Argument<int32_t>::New("threads").Default(1)).Get());
+    EXPECT_FALSE(child.Parse(Argument<type::Flag>::New("color").Default(type::Flag::True)).Get());
+    EXPECT_EQ("a b", child.Parse(Argument<std::string>::New("name")).Get());
+}
+
+TEST(WhispArgTest, ValidateUtf8ReportsTheTokenOfInvalidValues)
+{
+    // Arrange
+    auto commandLine =
+        CommandLine({"tool", "--name", "caf\xC3\xA9", "--label", "ab\xFF", "--count", "3", "--raw", "\xC0\xAF"});
+    auto parser = WhispArg(commandLine.Argc(), commandLine.Argv()).ValidateUtf8(true);
+
+    // Act
+    parser.Parse(Argument<std::string>::New("name"));
+    parser.Parse(Argument<std::string>::New("label"));
+    parser.Parse(Argument<int32_t>::New("count").Description("Bad \xE2\x82"));
+    auto unchecked = WhispArg(commandLine.Argc(), commandLine.Argv());
+    unchecked.Parse(Argument<std::string>::New("raw"));
+
+    // Assert
+    EXPECT_EQ((std::vector<std::string>{
+                  "Argument \"label\" is not valid UTF-8: invalid byte 0xFF at offset 2 of token 4.",
+                  "Description of argument \"count\" is not valid UTF-8: invalid byte 0xE2 at offset 4."}),
+              parser.Violations());
+    EXPECT_TRUE(unchecked.Violations().empty()); // validation is opt-in
+}
+
+TEST(WhispArgTest, HelpWrapsUtf8TextByCodePoints)
+{
+    // Arrange
+    auto commandLine = CommandLine({"tool"});
+    auto parser = WhispArg(commandLine.Argc(), commandLine.Argv()).Description("\xC3\xA9t\xC3\xA9 \xC3\xA9t\xC3\xA9");
+
+    // Act
+    auto help = parser.HelpString(9);
+
+    // Assert
+    EXPECT_NE(std::string::npos, help.find("\n\xC3\xA9t\xC3\xA9 \xC3\xA9t\xC3\xA9\n")); // 7 code points in 11 bytes
+}
+
+TEST(WhispArgTest, FromProcessReadsTheCommandLineOfTheProcess)
+{
+    // Act
+    const auto &arguments = WhispArg::ProcessArguments();
+    auto parser = WhispArg::FromProcess();
+    auto help = parser.HelpString(80);
+
+    // Assert
+    ASSERT_FALSE(arguments.empty());
+    EXPECT_NE(std::string_view::npos, arguments[0].find("WhispArgTest"));
+    EXPECT_EQ(arguments.data(), WhispArg::ProcessArguments().data()); // read only once
+    EXPECT_NE(std::string::npos, help.find("Usage: " + std::string(arguments[0]) + " [options]"));
+}
+
+TEST(WhispArgTest, ParseProcessSharesOneParserBetweenThreads)
+{
+    // Arrange
+    auto threads = std::vector<std::thread>();
+    auto values = std::vector<int32_t>(8);
+
+    // Act
+    for (auto i = std::size_t(0); i < values.size(); i++)
+    {
+        threads.emplace_back([&values, i]() {
+            auto name = "process-option-" + std::to_string(i);
+            values[i] = WhispArg::ParseProcess(Argument<int32_t>::New(name).Default(static_cast<int32_t>(i))).Get();
+        });
+    }
+    std::for_each(threads.begin(), threads.end(), [](std::thread &thread) { thread.join(); });
+    auto help = WhispArg::WithProcess([](WhispArg &parser) { return parser.HelpString(80); });
+
+    // Assert
+    for (auto i = std::size_t(0); i < values.size(); i++)
+    {
+        EXPECT_EQ(static_cast<int32_t>(i), values[i]);
+        EXPECT_NE(std::string::npos, help.find("--process-option-" + std::to_string(i))) << help;
+    }
+}